@@ -59,25 +59,25 @@ std::vector<geometry::segment_t> input() {
  *
  * @pre `std::cout` must be redirected to appropriate file stream before function call
  *
- * @param result A vector of intersection points to print
+ * @param result A flat list of intersection points to print
  * @param enable_color Commandline boolean flag which enables or disables printing in color
  */
-void output(const std::vector<sweepline::intersection_t> &result, bool enable_color) {
+void output(const sweepline::intersection_list &result, bool enable_color) {
     std::cout << fmt::format("  {}\n", result.size());
     // std::cout << fmt::format("{}\n", result.size());
-    for(auto it: result) {
+    for(size_t i = 0; i < result.size(); i++) {
         std::cout << format_col(enable_color,
             fmt::emphasis::faint | fg(fmt::color::medium_aquamarine),
-            "  ({:.3f}, {:.3f})  ", it.pt.x, it.pt.y
-            // "{:.10f} {:.10f} ", it.pt.x, it.pt.y
+            "  ({:.3f}, {:.3f})  ", result.points[i].x, result.points[i].y
+            // "{:.10f} {:.10f} ", result.points[i].x, result.points[i].y
         );
 
         bool fst = true;
-        for(int idx: it.segments) {
+        for(auto idx = result.segments_begin(i); idx != result.segments_end(i); ++idx) {
             std::cout << (fst? "" : ", ")
             // std::cout << (fst? "" : " ")
                 << format_col(enable_color,
-                        fmt::emphasis::faint | fg(fmt::color::khaki), "{}", idx + 1);
+                        fmt::emphasis::faint | fg(fmt::color::khaki), "{}", *idx + 1);
             fst = false;
         }
 
@@ -103,6 +103,7 @@ void output(const std::vector<sweepline::intersection_t> &result, bool enable_co
  * `-l --logf`     	| specify the log file                                                                  |
  * `-V --verbose`  	| write useful debug statements that describe the state at every stage [default: false] |
  * `-nc --nocolor` 	| disable color printing [default: false]                                               |
+ * `-j --threads`  	| number of threads to sweep with, 0 picks one per hardware thread [default: 1]         |
  *
  * @param argc The number of commandline arguments
  * @param argv A list of commandline arguments
@@ -120,7 +121,9 @@ int main(int argc, char *argv[]) {
     // finding intersections
     std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
 
-      std::vector<sweepline::intersection_t> result = sweepline::find_intersections(segments, params.verbose, params.enable_color);
+      sweepline::intersection_list result = params.num_threads == 1?
+        sweepline::find_intersection_list(segments, params.verbose, params.enable_color)
+        : sweepline::find_intersection_list_parallel(segments, params.num_threads);
 
     std::chrono::high_resolution_clock::duration total_runtime = std::chrono::high_resolution_clock::now() - start;
 
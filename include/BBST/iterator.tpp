@@ -32,8 +32,9 @@ struct raw_iterator {
      * @brief Construct a new raw iterator object
      *
      * @param ptr Pointer which the iterator will use under the hood
+     * @param nil Pointer to the sentinel node of the tree which owns \a ptr
      */
-    raw_iterator(node_t *ptr = nullptr): m_ptr(ptr) {}
+    raw_iterator(node_t *ptr = nullptr, node_t *nil = nullptr): m_ptr(ptr), m_nil(nil) {}
 
     /**
      * @brief Copy constructor
@@ -95,12 +96,12 @@ struct raw_iterator {
      * @brief Overloading the `++` operator (prefix increment)
      *
      * Calls node_t::next under the hood to get the next pointer. <br>
-     * Returns nullptr if there is no successor node.
+     * Returns the end iterator if there is no successor node.
      *
      * @return `raw_iterator&` An iterator to the successor node
      */
     raw_iterator &operator++() {
-        m_ptr = node_t::next(m_ptr);
+        m_ptr = node_t::next(m_ptr, m_nil);
         return *this;
     }
 
@@ -108,12 +109,12 @@ struct raw_iterator {
      * @brief Overloading the `--` operator (prefix decrement)
      *
      * Calls node_t::prev under the hood to get the previous pointer. <br>
-     * Returns nullptr if there is no predecessor node.
+     * Returns the end iterator if there is no predecessor node.
      *
      * @return `raw_iterator&` An iterator to the predecessor node
      */
     raw_iterator &operator--() {
-        m_ptr = node_t::prev(m_ptr);
+        m_ptr = node_t::prev(m_ptr, m_nil);
         return *this;
     }
 
@@ -121,13 +122,13 @@ struct raw_iterator {
      * @brief Overloading the `++` operator (postfix increment)
      *
      * Calls node_t::next under the hood to get the next pointer. <br>
-     * Returns nullptr if there is no successor node.
+     * Returns the end iterator if there is no successor node.
      *
      * @return `raw_iterator` An iterator to the successor node
      */
     raw_iterator operator++(int) {
         raw_iterator res{*this};
-        m_ptr = node_t::next(m_ptr);
+        m_ptr = node_t::next(m_ptr, m_nil);
         return res;
     }
 
@@ -135,13 +136,13 @@ struct raw_iterator {
      * @brief Overloading the `--` operator (postfix decrement)
      *
      * Calls node_t::prev under the hood to get the previous pointer. <br>
-     * Returns nullptr if there is no predecessor node.
+     * Returns the end iterator if there is no predecessor node.
      *
      * @return `raw_iterator` An iterator to the predecessor node
      */
     raw_iterator operator--(int) {
         raw_iterator res{*this};
-        m_ptr = node_t::prev(m_ptr);
+        m_ptr = node_t::prev(m_ptr, m_nil);
         return res;
     }
 
@@ -187,6 +188,9 @@ struct raw_iterator {
 protected:
     /// The underlying node pointer
     node_t *m_ptr;
+
+    /// The sentinel node of the tree which owns `m_ptr`, marks the end of the traversal
+    node_t *m_nil;
 };
 
 } // namespace BBST
\ No newline at end of file
@@ -0,0 +1,137 @@
+/**
+ * @file node_pool.tpp
+ * @author the-hyp0cr1t3
+ * @brief An allocator which hands out nodes from slabs it owns and recycles them through a free list
+ * @date 2026-10-17
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+
+namespace BBST {
+
+/**
+ * @brief The default allocator of `red_black_tree`, which hands out single objects from slabs and recycles them
+ *
+ * Objects are carved out of slabs which double in size up to `node_pool::max_slab_size` objects,
+ * and those deallocated are kept on a free list to be handed out again first, so a tree which erases
+ * as often as it inserts stops allocating once it has grown to its largest size.
+ * Every slab is released when the last copy of the pool is destroyed, usually along with the tree which owns it.
+ *
+ * Copies share the slabs and the free list of the pool they are copied from, like the node handles a tree
+ * hands out, so every slab lives on until the last copy is gone and a node may be deallocated through any of them.
+ * Pools rebound to another type, or selected for the copy of a container, start out empty.
+ *
+ * @tparam T The type of the objects, the nodes of the tree
+ */
+template <class T>
+class node_pool {
+    /// A slot of a slab, which holds an object while allocated and the next free slot otherwise
+    union slot {
+        slot *next;                                     ///< The next free slot, while on the free list
+        alignas(T) unsigned char storage[sizeof(T)];    ///< The storage of the object, while allocated
+    };
+
+    /// The slabs and free list shared by a pool and its copies
+    struct state {
+        std::vector<std::unique_ptr<slot[]>> slabs;   ///< The slabs allocated so far
+        slot *free_list { nullptr };                  ///< The slots deallocated, to be handed out first
+        slot *unused { nullptr };                     ///< The first slot of the last slab never handed out
+        slot *unused_end { nullptr };                 ///< Past the last slot of the last slab
+        size_t num_slabs_allocated { 0 };             ///< The number of slabs allocated so far, for tests and benchmarks
+    };
+
+    std::shared_ptr<state> pool;   ///< The state, created on the first allocation
+
+public:
+    using value_type = T;   ///< The type of the objects
+
+    static constexpr size_t min_slab_size = 16;     ///< The number of objects in the first slab
+    static constexpr size_t max_slab_size = 4096;   ///< The most objects in any one slab
+
+    /// @brief Construct an empty pool
+    node_pool() = default;
+
+    /// @brief Constructs a pool which shares the slabs of \a other
+    node_pool(const node_pool &other) = default;
+
+    /// @brief Constructs an empty pool for objects of type \a T from one for another type
+    template <class U>
+    node_pool(const node_pool<U> &) {}
+
+    /// @brief Takes over the slabs of \a other, which is left empty
+    node_pool(node_pool &&other) noexcept = default;
+
+    /// @return `node_pool` An empty pool, so that the copy of a container does not share the nodes of the original
+    node_pool select_on_container_copy_construction() const { return node_pool(); }
+
+    /// @brief Shares the slabs of \a other, leaving those of this pool to its other copies, if any
+    node_pool &operator = (const node_pool &other) = default;
+
+    /// @brief Takes over the slabs of \a other, which is left empty, leaving those of this pool to its other copies, if any
+    node_pool &operator = (node_pool &&other) noexcept = default;
+
+    /**
+     * @brief Allocates storage for \a n objects, from the pool if \a n is 1
+     *
+     * @param n The number of objects
+     * @return `T*` A pointer to the storage
+     */
+    T *allocate(size_t n) {
+        if(n != 1)
+            return std::allocator<T>().allocate(n);
+
+        if(!pool)
+            pool = std::make_shared<state>();
+
+        if(pool->free_list) {
+            slot *s = pool->free_list;
+            pool->free_list = s->next;
+            return reinterpret_cast<T *>(s->storage);
+        }
+
+        if(pool->unused == pool->unused_end) {
+            // each slab twice the size of the last up to max_slab_size, so that a tree of n nodes
+            // takes O(log(max_slab_size) + n / max_slab_size) slabs, and small trees stay small
+            size_t slab_size = std::min(min_slab_size << std::min(pool->slabs.size(), size_t(8)), max_slab_size);
+
+            pool->slabs.emplace_back(new slot[slab_size]);
+            pool->num_slabs_allocated++;
+            pool->unused = pool->slabs.back().get();
+            pool->unused_end = pool->unused + slab_size;
+        }
+
+        return reinterpret_cast<T *>((pool->unused++)->storage);
+    }
+
+    /**
+     * @brief Returns storage for \a n objects, to the free list if \a n is 1
+     *
+     * @param p A pointer to the storage, which must have been allocated by this pool or a copy of it
+     * @param n The number of objects
+     */
+    void deallocate(T *p, size_t n) {
+        if(n != 1)
+            return std::allocator<T>().deallocate(p, n);
+
+        slot *s = reinterpret_cast<slot *>(p);
+        s->next = pool->free_list;
+        pool->free_list = s;
+    }
+
+    /// @return `size_t` The number of slabs allocated from the heap so far
+    size_t num_slabs() const { return pool? pool->num_slabs_allocated : 0; }
+
+    /// @return `true` if \a a and \a b share their slabs, and so may deallocate what the other allocated
+    friend bool operator == (const node_pool &a, const node_pool &b) { return a.pool == b.pool; }
+
+    /// @return `true` if \a a and \a b do not share their slabs
+    friend bool operator != (const node_pool &a, const node_pool &b) { return a.pool != b.pool; }
+};
+
+} // namespace BBST
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <iterator.tpp>
+#include <node_pool.tpp>
 
 #include <memory>
 #include <utility>
@@ -23,69 +24,153 @@ enum color {
     BLACK   ///< Denotes a black node
 };
 
+/**
+ * @brief The default node update policy of `red_black_tree`, which keeps nothing in the nodes but their keys
+ */
+struct null_node_update {
+    /// The data kept in every node, none
+    struct metadata {};
+};
+
+/**
+ * @brief A node update policy which keeps the size of the subtree of every node, as that of `__gnu_pbds::tree`
+ *
+ * The sizes are kept up to date through every insertion, erase and rotation, at the cost of a word per node
+ * and a walk up to the root on every insertion and erase, and let `red_black_tree::order_of_key()`,
+ * `red_black_tree::find_by_order()` and `red_black_tree::order_of()` answer in O(log n).
+ */
+struct order_statistics_node_update {
+    /// The data kept in every node
+    struct metadata {
+        size_t subtree_size { 1 };   ///< The number of nodes in the subtree of the node, 0 for the sentinel
+    };
+};
+
 /**
  * @brief A generic node struct
  * @tparam T The type of the key
+ * @tparam Metadata The data the node update policy of the tree keeps in every node, an empty base if none
  */
-template <class T>
-struct node_impl {
-    const T key;        ///< The key value
+template <class T, class Metadata = null_node_update::metadata>
+struct node_impl : Metadata {
+    T key;              ///< The key value, only ever handed out as const, but swapped between nodes by `red_black_tree::reverse()`
 
-    node_impl *l;       ///< A pointer to the left child, points to `node_impl::sentinel_ptr` by default
-    node_impl *r;       ///< A pointer to the right child, points to `node_impl::sentinel_ptr` by default
-    node_impl *p;       ///< A pointer to the parent, points to `node_impl::sentinel_ptr` by default
+    node_impl *l;       ///< A pointer to the left child, points to the sentinel of the owning tree by default
+    node_impl *r;       ///< A pointer to the right child, points to the sentinel of the owning tree by default
+    node_impl *p;       ///< A pointer to the parent, points to the sentinel of the owning tree by default
 
     color col { RED };  ///< The colour of the node, RED by default
 
 
     /**
-     * @brief Construct a new node impl object
-     * @param key The key value
+     * @brief Construct a new node impl object, with its key constructed in place
+     * @param nil A pointer to the sentinel node of the tree which owns this node
+     * @param args The arguments to construct the key value from
      */
-    node_impl(const T &key)
-        : key(key), l(sentinel_ptr), r(sentinel_ptr), p(sentinel_ptr) {}
+    template <class... Args>
+    node_impl(node_impl *nil, Args &&...args)
+        : key(std::forward<Args>(args)...), l(nil), r(nil), p(nil) {}
 
     /**
      * @brief Finds the predecessor of a node
      *
      * @param it A pointer to the node
+     * @param sentinel_ptr A pointer to the sentinel node of the tree which owns \a it
      * @return `node_impl*` A pointer to the predecessor if it exists
-     * @return `nullptr` otherwise
+     * @return `sentinel_ptr` otherwise
      */
-    static node_impl *prev(node_impl *it);
+    static node_impl *prev(node_impl *it, const node_impl *sentinel_ptr);
 
     /**
      * @brief Finds the successor of a node
      *
      * @param it A pointer to the node
+     * @param sentinel_ptr A pointer to the sentinel node of the tree which owns \a it
      * @return `node_impl*` A pointer to the successor if it exists
-     * @return `nullptr` otherwise
+     * @return `sentinel_ptr` otherwise
      */
-    static node_impl *next(node_impl *it);
-
-    /// A pointer to the sentinel node
-    static node_impl *sentinel_ptr;
+    static node_impl *next(node_impl *it, const node_impl *sentinel_ptr);
 };
 
-/// Sentinel ptr definition
-template <class T>
-node_impl<T> *node_impl<T>::sentinel_ptr = nullptr;
+template <class T, class Compare, class Allocator, class NodeUpdate>
+class red_black_tree;
 
 /**
- * @brief Gets the sentinel node associated with `node_impl<T>` if it exists,
- * otherwise creates a new one and sets it as the designated sentinel node.
+ * @brief Owns a node extracted from a `red_black_tree`, like the `node_type` of `std::set`
+ *
+ * The node keeps its key and its memory while out of the tree, so it can be put back in, with its key
+ * changed if need be, without allocating or copying the key. The handle holds a copy of the allocator of the tree,
+ * through which a node still held when the handle is destroyed is returned, so it may outlive the tree, or the
+ * tree may be moved: copies of a `node_pool` share its slabs, which are released along with the last of them.
  *
  * @tparam T The type of the key
- * @return `node_impl<T>*` A pointer to the sentinel node.
+ * @tparam NodeAllocator The allocator of the nodes of the tree
  */
-template <class T>
-node_impl<T> *get_sentinel() {
-    if(!node_impl<T>::sentinel_ptr) {
-        node_impl<T>::sentinel_ptr = new node_impl<T>(T{});
-        node_impl<T>::sentinel_ptr->col = BLACK;
+template <class T, class NodeAllocator>
+class node_handle {
+    using node = typename std::allocator_traits<NodeAllocator>::value_type;
+    using node_traits = std::allocator_traits<NodeAllocator>;
+
+    node *ptr { nullptr };              ///< The node held, if any
+    NodeAllocator alloc {};             ///< A copy of the allocator of the tree the node was extracted from
+
+    /// @brief Takes ownership of \a ptr, allocated by \a alloc
+    node_handle(node *ptr, const NodeAllocator &alloc): ptr(ptr), alloc(alloc) {}
+
+    /// @brief Destroys the node held, if any
+    void reset() {
+        if(ptr) {
+            node_traits::destroy(alloc, ptr);
+            node_traits::deallocate(alloc, ptr, 1);
+            ptr = nullptr;
+        }
     }
-    return node_impl<T>::sentinel_ptr;
-}
+
+    template <class, class, class, class>
+    friend class red_black_tree;
+
+public:
+    using value_type = T;   ///< The type of the key
+
+    /// @brief Construct an empty node handle
+    node_handle() = default;
+
+    /// @brief Takes over the node of \a other, which is left empty
+    node_handle(node_handle &&other) noexcept
+        : ptr(std::exchange(other.ptr, nullptr)), alloc(std::move(other.alloc)) {}
+
+    /// @brief Destroys the node held, if any, and takes over that of \a other, which is left empty
+    node_handle &operator = (node_handle &&other) noexcept {
+        if(this != &other) {
+            reset();
+            ptr = std::exchange(other.ptr, nullptr);
+            alloc = std::move(other.alloc);
+        }
+        return *this;
+    }
+
+    /// \cond
+    node_handle(const node_handle &) = delete;
+    node_handle &operator = (const node_handle &) = delete;
+    /// \endcond
+
+    /// @brief Destroy the node handle object, along with the node held, if any
+    ~node_handle() { reset(); }
+
+    /// @return `true` if no node is held
+    bool empty() const { return !ptr; }
+
+    /// @return `true` if a node is held
+    explicit operator bool() const { return ptr; }
+
+    /**
+     * @brief Gets the key of the node held, which may be modified before it is inserted again
+     *
+     * @pre A node must be held
+     * @return `T&` The key
+     */
+    T &value() const { return ptr->key; }
+};
 
 /**
  * @brief A templated red black tree class
@@ -148,17 +233,46 @@ node_impl<T> *get_sentinel() {
  * }
  * @endcode
  *
+ * Nodes are allocated through \a Allocator, rebound to the node type, and returned to it as soon as they are erased.
+ * The default `node_pool` recycles them, so a tree which erases as often as it inserts allocates nothing once it
+ * has grown to its largest size, and frees them all at once along with the tree.
+ *
  * @tparam T The type of the key
  * @tparam Compare The type of the Compare functor
+ * @tparam Allocator The allocator of the nodes, e.g. `std::allocator<T>` to allocate each one from the heap
+ * @tparam NodeUpdate The node update policy, `order_statistics_node_update` to answer rank and select queries
  */
-template <class T, class Compare = std::less<T>>
+template <class T, class Compare = std::less<T>, class Allocator = node_pool<T>, class NodeUpdate = null_node_update>
 class red_black_tree {
     /// The compare functor
     Compare cmp {};
 
     /// A type alias for the nodes that will be used in the rbtree
-    using node = node_impl<T>;
-    node *sentinel_ptr { get_sentinel<T>() };
+    using node = node_impl<T, typename NodeUpdate::metadata>;
+
+    /// Whether the nodes keep the sizes of their subtrees
+    static constexpr bool order_statistics = std::is_same_v<NodeUpdate, order_statistics_node_update>;
+
+    /// A type alias for the allocator of the nodes
+    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<node>;
+
+    /// A type alias for the allocator traits of the nodes
+    using node_traits = std::allocator_traits<node_allocator>;
+
+    node_allocator alloc {};   ///< The allocator of the nodes, declared before them so that it outlives them
+
+    /**
+     * @brief Creates the sentinel node of a tree
+     *
+     * Every tree owns its sentinel, since erase writes through it (e.g. sets its parent),
+     * so that separate trees never share mutable state.
+     *
+     * @return `node*` A pointer to a new black node whose links point to itself
+     */
+    static node *create_sentinel();
+
+    std::unique_ptr<node> sentinel { create_sentinel() };   ///< The sentinel node owned by this tree
+    node *sentinel_ptr { sentinel.get() };                  ///< A pointer to the sentinel node
 
 public:
     /// A type alias for the iterator type that will be used in the rbtree
@@ -167,24 +281,113 @@ public:
     /// A type alias for the const iterator type that will be used in the rbtree
     using const_iterator = raw_iterator<const node, const T>;
 
+    /// A type alias for the handle of a node extracted from the rbtree
+    using node_type = node_handle<T, node_allocator>;
+
+    /// The result of inserting a node handle, as that of `std::set`
+    struct insert_return_type {
+        iterator position;   ///< An iterator to the inserted element, or to the element that prevented the insertion
+        bool inserted;       ///< `true` if the insertion took place
+        node_type node;      ///< The node handle, which still holds the node if the insertion did not take place
+    };
+
 private:
     size_t sz { 0 };                        ///< The size of the tree, i.e. number of nodes
 
     node *root { sentinel_ptr };            ///< A pointer to the root
 
-    iterator leftmost { sentinel_ptr };          ///< An iterator to the leftmost node
-    iterator rightmost { sentinel_ptr };         ///< An iterator to the rightmost node
-    const_iterator cleftmost { sentinel_ptr };   ///< A const iterator to the leftmost node
-    const_iterator crightmost { sentinel_ptr };  ///< A const iterator to the rightmost node
+    iterator leftmost { sentinel_ptr, sentinel_ptr };          ///< An iterator to the leftmost node
+    iterator rightmost { sentinel_ptr, sentinel_ptr };         ///< An iterator to the rightmost node
+    const_iterator cleftmost { sentinel_ptr, sentinel_ptr };   ///< A const iterator to the leftmost node
+    const_iterator crightmost { sentinel_ptr, sentinel_ptr };  ///< A const iterator to the rightmost node
 
     // ----------- helper methods ----------------
 
     /**
      * @brief Creates a new node and returns a pointer to it
      *
-     * @param key The key value of the new node
+     * @param args The arguments to construct the key value of the new node from
+     */
+    template <class... Args>
+    node *create_node(Args &&...args);
+
+    /**
+     * @brief Destroys a node and returns its memory to the allocator
+     *
+     * @param x A pointer to the node, which must no longer be linked into the tree
+     */
+    void destroy_node(node *x);
+
+    /**
+     * @brief Destroys every node of a subtree
+     *
+     * @param x A pointer to the root of the subtree
      */
-    node *create_node(const T &key);
+    void destroy_subtree(node *x);
+
+    /**
+     * @brief Finds where a key belongs in the tree
+     *
+     * @param key The key value
+     * @return `std::pair<node*, bool>` The node to be the parent of a new node with \a key and `true`,
+     * or the node which already has \a key and `false`
+     */
+    std::pair<node *, bool> find_parent(const T &key) const;
+
+    /**
+     * @brief Links an unlinked node into the tree below a given parent and rebalances it
+     *
+     * @param x A pointer to the node, whose links all point to the sentinel
+     * @param par A pointer to the parent, as found by `find_parent()`
+     * @return `iterator` An iterator to \a x
+     */
+    iterator link_node(node *x, node *par);
+
+    /**
+     * @brief Unlinks a node from the tree and rebalances it, without destroying the node
+     *
+     * @param it A pointer to the node
+     */
+    void unlink_node(node *it);
+
+    /**
+     * @brief Builds a balanced subtree out of the next \a n keys of a sorted range, in linear time
+     *
+     * The subtree is split evenly at every node, so its nil leaves lie on two levels at most,
+     * and only the nodes on the deepest level, \a red_depth, are coloured red.
+     *
+     * @param n The number of keys
+     * @param depth The depth of the root of the subtree
+     * @param red_depth The depth of the nodes to colour red, the deepest in the whole tree
+     * @param it An iterator to the next key, advanced past the \a n keys used
+     * @return `node*` A pointer to the root of the subtree, whose parent is left to the caller
+     */
+    template <typename InputIt>
+    node *build(size_t n, size_t depth, size_t red_depth, InputIt &it);
+
+    /**
+     * @brief Inserts a key, copied or moved into a new node, if it does not already exist
+     *
+     * @param key The key to be inserted
+     * @return `std::pair<iterator, bool>` As `insert()`
+     */
+    template <class K>
+    std::pair<iterator, bool> insert_key(K &&key);
+
+    /**
+     * @brief Recomputes the size of the subtree of a node from those of its children, if sizes are kept
+     *
+     * @param x A pointer to the node
+     */
+    static void update_size(node *x);
+
+    /**
+     * @brief Adds \a delta to the sizes of the subtrees of a node and all its ancestors, if sizes are kept
+     *
+     * @param x A pointer to the node, the sentinel for none
+     * @param delta The difference, +1 or -1 as a node is linked or unlinked below \a x
+     */
+    void add_size_to_path(node *x, size_t delta);
 
     /**
      * @brief Transplants node y onto node x
@@ -268,6 +471,24 @@ public:
      */
     red_black_tree(std::initializer_list<T> ilist);
 
+    /**
+     * @brief Construct a new red black tree object which takes over the nodes of another
+     *
+     * @param other The tree to take the nodes of, which is left empty
+     */
+    red_black_tree(red_black_tree &&other) noexcept;
+
+    /// \cond
+    red_black_tree(const red_black_tree &) = delete;
+    red_black_tree &operator = (const red_black_tree &) = delete;
+    red_black_tree &operator = (red_black_tree &&) = delete;
+    /// \endcond
+
+    /**
+     * @brief Destroy the red black tree object, along with all its nodes
+     */
+    ~red_black_tree();
+
     /**
      * @brief Gets the begin iterator
      * @return `iterator` begin
@@ -278,7 +499,7 @@ public:
      * @brief Gets the end iterator
      * @return `iterator` end
      */
-    iterator end() const { return iterator { sentinel_ptr }; }
+    iterator end() const { return iterator { sentinel_ptr, sentinel_ptr }; }
 
     /**
      * @brief Gets the begin const iterator
@@ -290,7 +511,7 @@ public:
      * @brief Gets the end const iterator
      * @return `iterator` end
      */
-    iterator cend() const { return const_iterator { sentinel_ptr }; }
+    iterator cend() const { return const_iterator { sentinel_ptr, sentinel_ptr }; }
 
     // utility methods
 
@@ -309,6 +530,13 @@ public:
      */
     bool  empty() const { return !sz; };
 
+    /**
+     * @brief Gets the compare functor
+     *
+     * @return `const Compare&` The compare functor the tree orders its keys by
+     */
+    const Compare &key_comp() const { return cmp; }
+
     /**
      * @brief Searches for an element with a given key
      *
@@ -347,6 +575,10 @@ public:
     /**
      * @brief Inserts a range
      *
+     * A range sorted in strictly increasing order is built in linear time into an empty tree,
+     * and appended without searching if its keys are all greater than those of the tree.
+     * Other ranges are inserted one key at a time.
+     *
      * @tparam InputItThe type of the input iterator
      * @tparam isIter Compund enable_if to only allow iterators
      * @param first An iterator pointing to the first element to be inserted
@@ -378,6 +610,36 @@ public:
      */
     std::pair<iterator, bool> insert(const T &key);
 
+    /**
+     * @brief Inserts a key into the tree, moving it into the new node, if it does not already exist
+     *
+     * @param key The key to be inserted
+     * @return std::pair<iterator, bool> As `insert(const T &)`
+     */
+    std::pair<iterator, bool> insert(T &&key);
+
+    /**
+     * @brief Inserts a node extracted by `extract()`, without allocating or copying its key
+     *
+     * @throws std::runtime_error if the node was allocated by an allocator which compares unequal to that of this tree
+     *
+     * @param nh The node handle, left empty if the insertion takes place
+     * @return `insert_return_type` An iterator to the inserted element (or to the element that prevented
+     * the insertion), whether the insertion took place, and the node if it did not
+     */
+    insert_return_type insert(node_type &&nh);
+
+    /**
+     * @brief Inserts a key constructed in place from \a args if it does not already exist
+     *
+     * The node is created before the search, and destroyed again if the key already exists.
+     *
+     * @param args The arguments to construct the key from
+     * @return std::pair<iterator, bool> As `insert(const T &)`
+     */
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args &&...args);
+
     // erase methods
 
     /**
@@ -405,6 +667,78 @@ public:
      */
     void erase(iterator first, iterator last);
 
+    /**
+     * @brief Unlinks a node from the tree, handing it over with its key instead of destroying it
+     *
+     * Iterators to the node are invalidated, those to other nodes stay valid.
+     *
+     * @param itr An iterator to the element to be extracted
+     * @return `node_type` A handle owning the node
+     */
+    node_type extract(iterator itr);
+
+    /**
+     * @brief Unlinks the node with a key from the tree if it exists, as `extract(iterator)`
+     *
+     * @param key The key to be extracted
+     * @return `node_type` A handle owning the node, empty if there is none with \a key
+     */
+    node_type extract(const T &key);
+
+    // order statistics, which need `order_statistics_node_update`
+
+    /**
+     * @brief Counts the keys less than a key in O(log n)
+     *
+     * @param key The key value, which need not be in the tree
+     * @return `size_t` The number of keys less than \a key, i.e. the position `lower_bound(key)` is at
+     */
+    size_t order_of_key(const T &key) const;
+
+    /**
+     * @brief Finds the key at a position in order in O(log n)
+     *
+     * @param k The position, starting from 0
+     * @return `iterator` An iterator to the key with \a k keys less than it, or end() if \a k is not less than size()
+     */
+    iterator find_by_order(size_t k) const;
+
+    /**
+     * @brief Finds the position in order of the key an iterator points to in O(log n), without comparing keys
+     *
+     * Meant for when the keys cannot be searched for, e.g. segments crossing at the sweepline,
+     * so that the keys between two iterators are counted as `order_of(last) - order_of(first)`.
+     *
+     * @param itr An iterator to a key, or end()
+     * @return `size_t` The number of keys less than the one \a itr points to, or size() for end()
+     */
+    size_t order_of(iterator itr) const;
+
+    /**
+     * @brief Checks the red black properties, the order of the keys and the sizes kept, for tests
+     *
+     * @return `true` if the tree is a valid red black tree
+     * @return `false` otherwise
+     */
+    bool is_valid() const;
+
+    // reordering methods
+
+    /**
+     * @brief Reverses the order of the keys in the range [first, last) in place
+     *
+     * Only the keys are swapped, the nodes stay where they are, so nothing is allocated and
+     * the compare functor is never called. Iterators keep pointing to the same positions, which now hold other keys.
+     * Meant for when the order of the keys changes along with the compare functor, e.g. for segments
+     * crossing at the sweepline.
+     *
+     * @pre The keys must be in order once reversed, including with respect to those outside the range.
+     *
+     * @param first An iterator to the first node of the range
+     * @param last An iterator to the position after the last node of the range
+     */
+    void reverse(iterator first, iterator last);
+
 };
 
 /**
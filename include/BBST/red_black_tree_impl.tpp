@@ -2,13 +2,56 @@
 
 namespace BBST {
 
-template <class T, class Compare>
-node_impl<T> *red_black_tree<T, Compare>::create_node(const T &key) {
-    return new node(key); // memory leak incoming...
+template <class T, class Compare, class Allocator, class NodeUpdate>
+template <class... Args>
+typename red_black_tree<T, Compare, Allocator, NodeUpdate>::node *red_black_tree<T, Compare, Allocator, NodeUpdate>::create_node(Args &&...args) {
+    node *x = node_traits::allocate(alloc, 1);
+    node_traits::construct(alloc, x, sentinel_ptr, std::forward<Args>(args)...);
+    return x;
 }
 
-template <class T>
-node_impl<T> *node_impl<T>::prev(node_impl<T> *it) {
+template <class T, class Compare, class Allocator, class NodeUpdate>
+void red_black_tree<T, Compare, Allocator, NodeUpdate>::destroy_node(node *x) {
+    node_traits::destroy(alloc, x);
+    node_traits::deallocate(alloc, x, 1);
+}
+
+template <class T, class Compare, class Allocator, class NodeUpdate>
+void red_black_tree<T, Compare, Allocator, NodeUpdate>::destroy_subtree(node *x) {
+    // recursion is only as deep as the tree, i.e. O(log n)
+    while(x != sentinel_ptr) {
+        destroy_subtree(x->l);
+        node *r = x->r;
+        destroy_node(x);
+        x = r;
+    }
+}
+
+template <class T, class Compare, class Allocator, class NodeUpdate>
+typename red_black_tree<T, Compare, Allocator, NodeUpdate>::node *red_black_tree<T, Compare, Allocator, NodeUpdate>::create_sentinel() {
+    node *nil = new node(nullptr);
+    nil->l = nil->r = nil->p = nil;
+    nil->col = BLACK;
+    if constexpr(order_statistics)
+        nil->subtree_size = 0;
+    return nil;
+}
+
+template <class T, class Compare, class Allocator, class NodeUpdate>
+void red_black_tree<T, Compare, Allocator, NodeUpdate>::update_size(node *x) {
+    if constexpr(order_statistics)
+        x->subtree_size = x->l->subtree_size + x->r->subtree_size + 1;
+}
+
+template <class T, class Compare, class Allocator, class NodeUpdate>
+void red_black_tree<T, Compare, Allocator, NodeUpdate>::add_size_to_path(node *x, size_t delta) {
+    if constexpr(order_statistics)
+        for(; x != sentinel_ptr; x = x->p)
+            x->subtree_size += delta;
+}
+
+template <class T, class Metadata>
+node_impl<T, Metadata> *node_impl<T, Metadata>::prev(node_impl *it, const node_impl *sentinel_ptr) {
 
     if(it == sentinel_ptr)
         throw std::runtime_error("Attempt to decrement nullptr");
@@ -30,8 +73,8 @@ node_impl<T> *node_impl<T>::prev(node_impl<T> *it) {
     return it;
 }
 
-template <class T>
-node_impl<T> *node_impl<T>::next(node_impl<T> *it) {
+template <class T, class Metadata>
+node_impl<T, Metadata> *node_impl<T, Metadata>::next(node_impl *it, const node_impl *sentinel_ptr) {
 
     if(it == sentinel_ptr)
         throw std::runtime_error("Attempt to increment nullptr");
@@ -53,8 +96,8 @@ node_impl<T> *node_impl<T>::next(node_impl<T> *it) {
     return it;
 }
 
-template <class T, class Compare>
-void red_black_tree<T, Compare>::transplant(node *x, node *y) {
+template <class T, class Compare, class Allocator, class NodeUpdate>
+void red_black_tree<T, Compare, Allocator, NodeUpdate>::transplant(node *x, node *y) {
     if(x->p == sentinel_ptr)
         root = y;
     else if(x == x->p->l)
@@ -64,8 +107,8 @@ void red_black_tree<T, Compare>::transplant(node *x, node *y) {
     y->p = x->p;
 }
 
-template <class T, class Compare>
-void red_black_tree<T, Compare>::left_rotate(node *x) {
+template <class T, class Compare, class Allocator, class NodeUpdate>
+void red_black_tree<T, Compare, Allocator, NodeUpdate>::left_rotate(node *x) {
     node *y = x->r;
     x->r = y->l;
     if(y->l != sentinel_ptr)
@@ -81,10 +124,16 @@ void red_black_tree<T, Compare>::left_rotate(node *x) {
 
     y->l = x;
     x->p = y;
+
+    // y takes the place of x, along with the size of its subtree
+    if constexpr(order_statistics) {
+        y->subtree_size = x->subtree_size;
+        update_size(x);
+    }
 }
 
-template <class T, class Compare>
-void red_black_tree<T, Compare>::right_rotate(node *y) {
+template <class T, class Compare, class Allocator, class NodeUpdate>
+void red_black_tree<T, Compare, Allocator, NodeUpdate>::right_rotate(node *y) {
     node *x = y->l;
     y->l = x->r;
     if(x->r != sentinel_ptr)
@@ -100,10 +149,16 @@ void red_black_tree<T, Compare>::right_rotate(node *y) {
 
     x->r = y;
     y->p = x;
+
+    // x takes the place of y, along with the size of its subtree
+    if constexpr(order_statistics) {
+        x->subtree_size = y->subtree_size;
+        update_size(y);
+    }
 }
 
-template <class T, class Compare>
-void red_black_tree<T, Compare>::fix_insert(node *z) {
+template <class T, class Compare, class Allocator, class NodeUpdate>
+void red_black_tree<T, Compare, Allocator, NodeUpdate>::fix_insert(node *z) {
 
     while(z->p->col == RED) {
 
@@ -147,8 +202,8 @@ void red_black_tree<T, Compare>::fix_insert(node *z) {
     root->col = BLACK;
 }
 
-template <class T, class Compare>
-void red_black_tree<T, Compare>::fix_erase(node *x) {
+template <class T, class Compare, class Allocator, class NodeUpdate>
+void red_black_tree<T, Compare, Allocator, NodeUpdate>::fix_erase(node *x) {
 
     while(x != root and x->col == BLACK) {
 
@@ -222,27 +277,49 @@ void red_black_tree<T, Compare>::fix_erase(node *x) {
 }
 
 // ctors
-template <class T, class Compare>
-red_black_tree<T, Compare>::red_black_tree(T, Compare &&_cmp)
+template <class T, class Compare, class Allocator, class NodeUpdate>
+red_black_tree<T, Compare, Allocator, NodeUpdate>::red_black_tree(T, Compare &&_cmp)
     : cmp(std::forward<Compare>(_cmp)) {}
 
-template <class T, class Compare>
-red_black_tree<T, Compare>::red_black_tree(Compare _cmp): cmp(_cmp) {}
+template <class T, class Compare, class Allocator, class NodeUpdate>
+red_black_tree<T, Compare, Allocator, NodeUpdate>::red_black_tree(Compare _cmp): cmp(_cmp) {}
 
-template <class T, class Compare>
+template <class T, class Compare, class Allocator, class NodeUpdate>
 template <typename InputIt, typename isIter>
-red_black_tree<T, Compare>::red_black_tree(InputIt first, InputIt last) {
+red_black_tree<T, Compare, Allocator, NodeUpdate>::red_black_tree(InputIt first, InputIt last) {
     insert(first, last);
 }
 
-template <class T, class Compare>
-red_black_tree<T, Compare>::red_black_tree(std::initializer_list<T> ilist) {
+template <class T, class Compare, class Allocator, class NodeUpdate>
+red_black_tree<T, Compare, Allocator, NodeUpdate>::red_black_tree(std::initializer_list<T> ilist) {
     insert(ilist.begin(), ilist.end());
 }
 
+template <class T, class Compare, class Allocator, class NodeUpdate>
+red_black_tree<T, Compare, Allocator, NodeUpdate>::red_black_tree(red_black_tree &&other) noexcept
+    : cmp(std::move(other.cmp)), alloc(std::move(other.alloc)),
+      sentinel(std::move(other.sentinel)), sentinel_ptr(other.sentinel_ptr),
+      sz(other.sz), root(other.root),
+      leftmost(other.leftmost), rightmost(other.rightmost),
+      cleftmost(other.cleftmost), crightmost(other.crightmost) {
+
+    // the nodes link to the sentinel, which moves along with them, so other gets a new one
+    other.sentinel.reset(create_sentinel());
+    other.sentinel_ptr = other.sentinel.get();
+    other.sz = 0;
+    other.root = other.sentinel_ptr;
+    other.leftmost = other.rightmost = iterator { other.sentinel_ptr, other.sentinel_ptr };
+    other.cleftmost = other.crightmost = const_iterator { other.sentinel_ptr, other.sentinel_ptr };
+}
+
+template <class T, class Compare, class Allocator, class NodeUpdate>
+red_black_tree<T, Compare, Allocator, NodeUpdate>::~red_black_tree() {
+    destroy_subtree(root);
+}
+
 // utility
-template <class T, class Compare>
-typename red_black_tree<T, Compare>::iterator red_black_tree<T, Compare>::find(const T &key) const {
+template <class T, class Compare, class Allocator, class NodeUpdate>
+typename red_black_tree<T, Compare, Allocator, NodeUpdate>::iterator red_black_tree<T, Compare, Allocator, NodeUpdate>::find(const T &key) const {
     node *it = root;
 
     while(it != sentinel_ptr) {
@@ -250,21 +327,21 @@ typename red_black_tree<T, Compare>::iterator red_black_tree<T, Compare>::find(c
         bool is_greater = cmp(it->key, key);
 
         if(!is_less and !is_greater)
-            return iterator { it };
+            return iterator { it, sentinel_ptr };
 
         it = is_less? it->l : it->r;
     }
 
-    return iterator { sentinel_ptr };
+    return iterator { sentinel_ptr, sentinel_ptr };
 }
 
-template <class T, class Compare>
-bool red_black_tree<T, Compare>::contains(const T &key) const {
+template <class T, class Compare, class Allocator, class NodeUpdate>
+bool red_black_tree<T, Compare, Allocator, NodeUpdate>::contains(const T &key) const {
     return find(key) != end();
 }
 
-template <class T, class Compare>
-typename red_black_tree<T, Compare>::iterator red_black_tree<T, Compare>::lower_bound(const T &key) const {
+template <class T, class Compare, class Allocator, class NodeUpdate>
+typename red_black_tree<T, Compare, Allocator, NodeUpdate>::iterator red_black_tree<T, Compare, Allocator, NodeUpdate>::lower_bound(const T &key) const {
     node *it = root, *lb = sentinel_ptr;
 
     while(it != sentinel_ptr) {
@@ -273,11 +350,11 @@ typename red_black_tree<T, Compare>::iterator red_black_tree<T, Compare>::lower_
         else it = it->r;
     }
 
-    return iterator { lb };
+    return iterator { lb, sentinel_ptr };
 }
 
-template <class T, class Compare>
-typename red_black_tree<T, Compare>::iterator red_black_tree<T, Compare>::upper_bound(const T &key) const {
+template <class T, class Compare, class Allocator, class NodeUpdate>
+typename red_black_tree<T, Compare, Allocator, NodeUpdate>::iterator red_black_tree<T, Compare, Allocator, NodeUpdate>::upper_bound(const T &key) const {
     node *it = root, *ub = sentinel_ptr;
 
     while(it != sentinel_ptr) {
@@ -286,25 +363,77 @@ typename red_black_tree<T, Compare>::iterator red_black_tree<T, Compare>::upper_
         else it = it->r;
     }
 
-    return iterator { ub };
+    return iterator { ub, sentinel_ptr };
 }
 
-template <class T, class Compare>
+template <class T, class Compare, class Allocator, class NodeUpdate>
+template <typename InputIt>
+typename red_black_tree<T, Compare, Allocator, NodeUpdate>::node *red_black_tree<T, Compare, Allocator, NodeUpdate>::build(size_t n, size_t depth, size_t red_depth, InputIt &it) {
+    if(n == 0)
+        return sentinel_ptr;
+
+    node *l = build((n - 1) / 2, depth + 1, red_depth, it);
+    node *x = create_node(*it);
+    ++it;
+    node *r = build(n / 2, depth + 1, red_depth, it);
+
+    x->l = l, x->r = r;
+    if(l != sentinel_ptr)
+        l->p = x;
+    if(r != sentinel_ptr)
+        r->p = x;
+
+    x->col = depth == red_depth? RED : BLACK;
+    if constexpr(order_statistics)
+        x->subtree_size = n;
+
+    return x;
+}
+
+template <class T, class Compare, class Allocator, class NodeUpdate>
 template <typename InputIt, typename isIter>
-void red_black_tree<T, Compare>::insert(InputIt first, InputIt last) {
+void red_black_tree<T, Compare, Allocator, NodeUpdate>::insert(InputIt first, InputIt last) {
+    bool increasing = std::adjacent_find(first, last, [this](const T &a, const T &b) { return !cmp(a, b); }) == last;
+
+    if(first != last and increasing and sz == 0) {
+        // every path to a nil leaf has as many black nodes as there are levels above the deepest one,
+        // which is red unless it is the root alone
+        size_t n = std::distance(first, last);
+        size_t red_depth = n > 1? 63 - __builtin_clzll(n) : size_t(-1);
+
+        root = build(n, 0, red_depth, first);
+        sz = n;
+
+        node *lo = root, *hi = root;
+        while(lo->l != sentinel_ptr)
+            lo = lo->l;
+        while(hi->r != sentinel_ptr)
+            hi = hi->r;
+        leftmost = iterator { lo, sentinel_ptr };
+        rightmost = iterator { hi, sentinel_ptr };
+        return;
+    }
+
+    if(first != last and increasing and cmp(*rightmost, *first)) {
+        // every key goes right of the greatest one, so no search is needed
+        for(; first != last; ++first)
+            link_node(create_node(*first), rightmost.get_ptr());
+        return;
+    }
+
     while(first != last) {
         insert(*first);
         ++first;
     }
 }
 
-template <class T, class Compare>
-void red_black_tree<T, Compare>::insert(std::initializer_list<T> ilist) {
+template <class T, class Compare, class Allocator, class NodeUpdate>
+void red_black_tree<T, Compare, Allocator, NodeUpdate>::insert(std::initializer_list<T> ilist) {
     insert(ilist.begin(), ilist.end());
 }
 
-template <class T, class Compare>
-std::pair<typename red_black_tree<T, Compare>::iterator, bool> red_black_tree<T, Compare>::insert(const T &key) {
+template <class T, class Compare, class Allocator, class NodeUpdate>
+std::pair<typename red_black_tree<T, Compare, Allocator, NodeUpdate>::node *, bool> red_black_tree<T, Compare, Allocator, NodeUpdate>::find_parent(const T &key) const {
     node *it = root, *par = sentinel_ptr;
 
     while(it != sentinel_ptr) {
@@ -312,79 +441,280 @@ std::pair<typename red_black_tree<T, Compare>::iterator, bool> red_black_tree<T,
         bool is_greater = cmp(it->key, key);
 
         if(!is_less and !is_greater)
-            return { iterator { it }, false };      // already present
+            return { it, false };      // already present
 
         par = it;
         it = is_less? it->l : it->r;
     }
 
+    return { par, true };
+}
+
+template <class T, class Compare, class Allocator, class NodeUpdate>
+typename red_black_tree<T, Compare, Allocator, NodeUpdate>::iterator red_black_tree<T, Compare, Allocator, NodeUpdate>::link_node(node *new_node, node *par) {
     ++sz;
-    node *new_node = create_node(key);
     new_node->p = par;
-
-    if(par == sentinel_ptr)
+    if constexpr(order_statistics)
+        new_node->subtree_size = 1;
+    add_size_to_path(par, 1);
+
+    // the new node is leftmost (rightmost) iff it hangs left (right) of the old one or the tree was empty,
+    // decided by where it is linked since a time varying comparator may not order it against the old one
+    iterator itr { new_node, sentinel_ptr };
+    if(par == sentinel_ptr) {
         root = new_node;
-    else if(cmp(key, par->key))
+        leftmost = rightmost = itr;
+
+    } else if(cmp(new_node->key, par->key)) {
         par->l = new_node;
-    else
+        if(par == leftmost.get_ptr())
+            leftmost = itr;
+
+    } else {
         par->r = new_node;
+        if(par == rightmost.get_ptr())
+            rightmost = itr;
+    }
 
     fix_insert(new_node);
 
-    if(leftmost == end() or cmp(key, *leftmost))
-        leftmost = new_node;
+    return itr;
+}
+
+template <class T, class Compare, class Allocator, class NodeUpdate>
+template <class K>
+std::pair<typename red_black_tree<T, Compare, Allocator, NodeUpdate>::iterator, bool> red_black_tree<T, Compare, Allocator, NodeUpdate>::insert_key(K &&key) {
+    auto [par, unique] = find_parent(key);
+    if(!unique)
+        return { iterator { par, sentinel_ptr }, false };
 
-    if(rightmost == end() or cmp(*rightmost, key))
-        rightmost = new_node;
+    return { link_node(create_node(std::forward<K>(key)), par), true };
+}
+
+template <class T, class Compare, class Allocator, class NodeUpdate>
+std::pair<typename red_black_tree<T, Compare, Allocator, NodeUpdate>::iterator, bool> red_black_tree<T, Compare, Allocator, NodeUpdate>::insert(const T &key) {
+    return insert_key(key);
+}
 
-    return { iterator { new_node }, true };
+template <class T, class Compare, class Allocator, class NodeUpdate>
+std::pair<typename red_black_tree<T, Compare, Allocator, NodeUpdate>::iterator, bool> red_black_tree<T, Compare, Allocator, NodeUpdate>::insert(T &&key) {
+    return insert_key(std::move(key));
 }
 
-template <class T, class Compare>
-bool red_black_tree<T, Compare>::erase(const T &key) {
+template <class T, class Compare, class Allocator, class NodeUpdate>
+typename red_black_tree<T, Compare, Allocator, NodeUpdate>::insert_return_type red_black_tree<T, Compare, Allocator, NodeUpdate>::insert(node_type &&nh) {
+    if(nh.empty())
+        return { end(), false, node_type {} };
+
+    if(!(nh.alloc == alloc))
+        throw std::runtime_error("Attempt to insert a node from an incompatible allocator");
+
+    auto [par, unique] = find_parent(nh.value());
+    if(!unique)
+        return { iterator { par, sentinel_ptr }, false, std::move(nh) };
+
+    // the node may come from another tree, so its links are reset to point to this tree's sentinel
+    node *x = std::exchange(nh.ptr, nullptr);
+    x->l = x->r = x->p = sentinel_ptr;
+    x->col = RED;
+
+    return { link_node(x, par), true, node_type {} };
+}
+
+template <class T, class Compare, class Allocator, class NodeUpdate>
+template <class... Args>
+std::pair<typename red_black_tree<T, Compare, Allocator, NodeUpdate>::iterator, bool> red_black_tree<T, Compare, Allocator, NodeUpdate>::emplace(Args &&...args) {
+    node *x = create_node(std::forward<Args>(args)...);
+
+    auto [par, unique] = find_parent(x->key);
+    if(!unique) {
+        destroy_node(x);
+        return { iterator { par, sentinel_ptr }, false };
+    }
+
+    return { link_node(x, par), true };
+}
+
+template <class T, class Compare, class Allocator, class NodeUpdate>
+bool red_black_tree<T, Compare, Allocator, NodeUpdate>::erase(const T &key) {
     iterator itr = find(key);
     if(itr == end())
         return false;
     return erase(itr), true;
 }
 
-template <class T, class Compare>
-void red_black_tree<T, Compare>::erase(iterator first, iterator last) {
-    while(first != last) {
-        erase(first);
-        ++first;
+template <class T, class Compare, class Allocator, class NodeUpdate>
+void red_black_tree<T, Compare, Allocator, NodeUpdate>::erase(iterator first, iterator last) {
+    while(first != last)
+        first = erase(first);
+}
+
+template <class T, class Compare, class Allocator, class NodeUpdate>
+size_t red_black_tree<T, Compare, Allocator, NodeUpdate>::order_of_key(const T &key) const {
+    static_assert(order_statistics, "order_of_key() needs BBST::order_statistics_node_update");
+
+    node *it = root;
+    size_t rank = 0;
+
+    while(it != sentinel_ptr) {
+        if(cmp(it->key, key))       // it->key < key, as are all keys to its left
+            rank += it->l->subtree_size + 1, it = it->r;
+        else it = it->l;
+    }
+
+    return rank;
+}
+
+template <class T, class Compare, class Allocator, class NodeUpdate>
+typename red_black_tree<T, Compare, Allocator, NodeUpdate>::iterator red_black_tree<T, Compare, Allocator, NodeUpdate>::find_by_order(size_t k) const {
+    static_assert(order_statistics, "find_by_order() needs BBST::order_statistics_node_update");
+
+    node *it = root;
+
+    while(it != sentinel_ptr) {
+        size_t left = it->l->subtree_size;
+
+        if(k == left)
+            return iterator { it, sentinel_ptr };
+
+        if(k < left)
+            it = it->l;
+        else k -= left + 1, it = it->r;
     }
+
+    return iterator { sentinel_ptr, sentinel_ptr };
 }
 
-template <class T, class Compare>
-typename red_black_tree<T, Compare>::iterator red_black_tree<T, Compare>::erase(iterator itr) {
+template <class T, class Compare, class Allocator, class NodeUpdate>
+size_t red_black_tree<T, Compare, Allocator, NodeUpdate>::order_of(iterator itr) const {
+    static_assert(order_statistics, "order_of() needs BBST::order_statistics_node_update");
+
+    node *it = itr.get_ptr();
+    if(it == sentinel_ptr)
+        return sz;
+
+    // the keys to the left of the node, and of every ancestor it lies to the right of
+    size_t rank = it->l->subtree_size;
+    for(; it->p != sentinel_ptr; it = it->p)
+        if(it == it->p->r)
+            rank += it->p->l->subtree_size + 1;
+
+    return rank;
+}
+
+template <class T, class Compare, class Allocator, class NodeUpdate>
+bool red_black_tree<T, Compare, Allocator, NodeUpdate>::is_valid() const {
+    if(root != sentinel_ptr and (root->p != sentinel_ptr or root->col != BLACK))
+        return false;
+
+    // the black height of a subtree, or -1 if it is not a valid one
+    auto check = [this](auto &&self, const node *x) -> long {
+        if(x == sentinel_ptr)
+            return 0;
+
+        if(x->l != sentinel_ptr and (x->l->p != x or !cmp(x->l->key, x->key)))
+            return -1;
+        if(x->r != sentinel_ptr and (x->r->p != x or !cmp(x->key, x->r->key)))
+            return -1;
+        if(x->col == RED and (x->l->col == RED or x->r->col == RED))
+            return -1;
+        if constexpr(order_statistics)
+            if(x->subtree_size != x->l->subtree_size + x->r->subtree_size + 1)
+                return -1;
+
+        long lh = self(self, x->l), rh = self(self, x->r);
+        if(lh < 0 or lh != rh)
+            return -1;
+        return lh + (x->col == BLACK);
+    };
+
+    if(check(check, root) < 0)
+        return false;
+
+    // the keys increase in order, which the checks on children alone do not ensure
+    size_t n = 0;
+    for(auto it = begin(), prev = end(); it != end(); prev = it, ++it, n++)
+        if(prev != end() and !cmp(*prev, *it))
+            return false;
+
+    return n == sz and (sz == 0 or (leftmost.get_ptr()->l == sentinel_ptr and rightmost.get_ptr()->r == sentinel_ptr));
+}
+
+template <class T, class Compare, class Allocator, class NodeUpdate>
+void red_black_tree<T, Compare, Allocator, NodeUpdate>::reverse(iterator first, iterator last) {
+    if(first == last)
+        return;
+
+    // walk inwards from both ends, swapping the keys of the nodes on either side
+    node *lo = first.get_ptr();
+    node *hi = last == end()? rightmost.get_ptr() : node::prev(last.get_ptr(), sentinel_ptr);
+
+    while(lo != hi) {
+        std::swap(lo->key, hi->key);
+        lo = node::next(lo, sentinel_ptr);
+        if(lo == hi)
+            break;
+        hi = node::prev(hi, sentinel_ptr);
+    }
+}
+
+template <class T, class Compare, class Allocator, class NodeUpdate>
+typename red_black_tree<T, Compare, Allocator, NodeUpdate>::iterator red_black_tree<T, Compare, Allocator, NodeUpdate>::erase(iterator itr) {
     if(itr == end())
         throw std::runtime_error("Attempt to erase past the end iterator");
 
     node *it = itr.get_ptr();
+    iterator nxt { node::next(it, sentinel_ptr), sentinel_ptr };
 
-    iterator nxt { node::next(it) };
+    unlink_node(it);
+    destroy_node(it);
+    return nxt;
+}
+
+template <class T, class Compare, class Allocator, class NodeUpdate>
+typename red_black_tree<T, Compare, Allocator, NodeUpdate>::node_type red_black_tree<T, Compare, Allocator, NodeUpdate>::extract(iterator itr) {
+    if(itr == end())
+        throw std::runtime_error("Attempt to extract past the end iterator");
+
+    unlink_node(itr.get_ptr());
+    return node_type { itr.get_ptr(), alloc };
+}
+
+template <class T, class Compare, class Allocator, class NodeUpdate>
+typename red_black_tree<T, Compare, Allocator, NodeUpdate>::node_type red_black_tree<T, Compare, Allocator, NodeUpdate>::extract(const T &key) {
+    iterator itr = find(key);
+    if(itr == end())
+        return node_type {};
+    return extract(itr);
+}
+
+template <class T, class Compare, class Allocator, class NodeUpdate>
+void red_black_tree<T, Compare, Allocator, NodeUpdate>::unlink_node(node *it) {
+    iterator itr { it, sentinel_ptr };
 
     if(itr == leftmost)
-        leftmost = nxt;
+        leftmost = iterator { node::next(it, sentinel_ptr), sentinel_ptr };
 
     if(itr == rightmost)
-        rightmost = iterator { node::prev(it) };
+        rightmost = iterator { node::prev(it, sentinel_ptr), sentinel_ptr };
 
     if(!--sz) {
         root = sentinel_ptr;
-        return nxt;
+        return;
     }
 
     color orig_col = it->col;
 
+    // the subtrees on the path from the node taken out of its place, it or its successor, lose a node
     node *x, *y = it;
     if(it->l == sentinel_ptr) {
         x = it->r;
+        add_size_to_path(it->p, size_t(-1));
         transplant(it, it->r);
 
     } else if(it->r == sentinel_ptr) {
         x = it->l;
+        add_size_to_path(it->p, size_t(-1));
         transplant(it, it->l);
 
     } else {
@@ -392,6 +722,7 @@ typename red_black_tree<T, Compare>::iterator red_black_tree<T, Compare>::erase(
         while(y->l != sentinel_ptr)
             y = y->l;
 
+        add_size_to_path(y->p, size_t(-1));
         orig_col = y->col;
         x = y->r;
 
@@ -407,12 +738,12 @@ typename red_black_tree<T, Compare>::iterator red_black_tree<T, Compare>::erase(
         y->l = it->l;
         y->l->p = y;
         y->col = it->col;
+        if constexpr(order_statistics)
+            y->subtree_size = it->subtree_size;
     }
 
     if(orig_col == BLACK)
         fix_erase(x);
-
-    return nxt;
 }
 
 } // namespace BBST
\ No newline at end of file
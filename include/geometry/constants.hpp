@@ -11,11 +11,41 @@
 
 namespace geometry {
 
-  /// Underlying type for all computations
+  /// Underlying type for all computations, unless another scalar type is asked for explicitly
   using float_t = double;
 
-  /// Permissible error; in other words, limiting accuracy
-  inline constexpr float_t EPS = std::numeric_limits<float>::epsilon();
+  /**
+   * @brief Permissible error for computations in scalar type \a T; in other words, limiting accuracy
+   *
+   * Doubles are good to `std::numeric_limits<float>::epsilon()` over a wide range of coordinates.
+   * Floats only carry 24 bits, which have to cover both the rounding of stored points and the distance
+   * between distinct features, so their tolerance of \f$ 2^{-14} \f$ is meant for coordinates of magnitude
+   * up to about \f$ 16 \f$, e.g. normalized to the unit square, whose features lie more than \f$ 10^{-4} \f$ apart.
+   * The rounding of a stored point is multiplied by the slope of a segment through it, so among a few thousand
+   * segments with steep ones crossing close together, a sweep in floats misses a few percent of the crossings
+   * a sweep in doubles finds; floats trade that accuracy for memory.
+   *
+   * @tparam T The scalar type, `float` or `double`
+   */
+  template <typename T>
+  inline constexpr T tolerance = T(std::numeric_limits<float>::epsilon());
+
+  /// \cond
+  template <>
+  inline constexpr float tolerance<float> = 0x1p-14f;
+  /// \endcond
+
+  /**
+   * @brief The type computations on scalar type \a T are carried out in
+   *
+   * Floats are widened to double, which holds their products exactly, so that results are only rounded
+   * once when they are stored back. Only the storage, and hence the memory traffic, is halved.
+   */
+  template <typename T>
+  using compute_t = decltype(T() * double());
+
+  /// Permissible error of `float_t`; in other words, limiting accuracy
+  inline constexpr float_t EPS = tolerance<float_t>;
 
   /// \cond
   inline constexpr float_t EPS_INC = 5 * EPS;
@@ -0,0 +1,393 @@
+/**
+ * @file exact.hpp
+ * @author the-hyp0cr1t3
+ * @brief Exact predicates and constructions on segments with integer coordinates
+ * @date 2026-10-17
+ */
+#pragma once
+
+#include <point.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+
+namespace geometry {
+
+  /// Signed 128 bit integer, wide enough for most of the products computed by the exact predicates
+  using int128_t = __int128;
+
+  /**
+   * @brief The bound on the absolute value of an integer coordinate, which must be strictly less
+   *
+   * Differences of coordinates then fit in 31 bits, and every product computed by the exact predicates
+   * in at most 192 bits, of which all but the comparisons of two intersection points fit in `int128_t`.
+   */
+  inline constexpr std::int64_t EXACT_COORD_LIMIT = std::int64_t(1) << 30;
+
+  /**
+   * @brief A point with integer coordinates
+   *
+   * @tparam Int The signed integer coordinate type, `std::int32_t` or `std::int64_t`
+   */
+  template <typename Int>
+  struct ipoint_t {
+    static_assert(std::is_integral_v<Int> and std::is_signed_v<Int>, "coordinates must be signed integers");
+
+    /// The x coordinate of the point
+    Int x;
+
+    /// The y coordinate of the point
+    Int y;
+
+    /// Compares exactly, unlike `point_t`
+    bool operator == (const ipoint_t &other) const { return x == other.x and y == other.y; }
+
+    /// \cond
+    bool operator != (const ipoint_t &other) const { return !(*this == other); }
+    /// \endcond
+  };
+
+  /**
+   * @brief A segment with integer coordinates
+   * @warning \f$ p \le q \f$ must hold for the algorithm to work (comparing on the tuple `<x, y>`)
+   *
+   * @tparam Int The signed integer coordinate type, `std::int32_t` or `std::int64_t`
+   */
+  template <typename Int>
+  struct isegment_t {
+    /// The point where the segment begins
+    ipoint_t<Int> p;
+
+    /// The point where the segment ends
+    ipoint_t<Int> q;
+
+    /// The index of the segment in input
+    size_t seg_id;
+  };
+
+  /// \cond
+  namespace detail {
+
+    inline int sign(int128_t v) { return (v > 0) - (v < 0); }
+
+    inline bool fits_int64(int128_t v) { return v == int128_t(std::int64_t(v)); }
+
+    // the sign of a * b - c * d, where each product may take up to 192 bits
+    inline int compare_products(int128_t a, std::int64_t b, int128_t c, std::int64_t d) {
+      if(fits_int64(a) and fits_int64(c))
+        return sign(a * b - c * d);
+
+      using uint128_t = unsigned __int128;
+
+      // magnitude hi:lo and sign of a product
+      struct wide { int sgn; std::uint64_t hi; uint128_t lo; };
+      auto mul = [](int128_t x, std::int64_t y) {
+        wide w { sign(x) * ((y > 0) - (y < 0)), 0, 0 };
+        uint128_t ux = x < 0? -uint128_t(x) : uint128_t(x);
+        std::uint64_t uy = y < 0? -std::uint64_t(y) : std::uint64_t(y);
+        uint128_t p0 = uint128_t(std::uint64_t(ux)) * uy;
+        uint128_t p1 = uint128_t(std::uint64_t(ux >> 64)) * uy;
+        w.lo = p0 + (p1 << 64);
+        w.hi = std::uint64_t(p1 >> 64) + (w.lo < p0);
+        return w;
+      };
+
+      wide l = mul(a, b), r = mul(c, d);
+      if(l.sgn != r.sgn)
+        return l.sgn < r.sgn? -1 : +1;
+
+      int mag = l.hi != r.hi? (l.hi < r.hi? -1 : +1) : l.lo != r.lo? (l.lo < r.lo? -1 : +1) : 0;
+      return l.sgn * mag;
+    }
+
+  } // namespace detail
+  /// \endcond
+
+  /**
+   * @brief A point with rational coordinates \f$ (nx / d, ny / d) \f$, as where two integer segments intersect
+   *
+   * Points are compared exactly, so the same point may be represented with different denominators.
+   */
+  struct rational_point_t {
+    /// The numerator of the x coordinate
+    int128_t nx;
+
+    /// The numerator of the y coordinate
+    int128_t ny;
+
+    /// The common denominator, always positive
+    std::int64_t d;
+
+    /// The x coordinate rounded to floating point, which decides most comparisons without multiplying out
+    float_t x_approx;
+
+    /**
+     * @brief Makes a point from its numerators and denominator
+     *
+     * @param nx The numerator of the x coordinate
+     * @param ny The numerator of the y coordinate
+     * @param d The common denominator, which must be positive
+     * @return `rational_point_t` The point \f$ (nx / d, ny / d) \f$
+     */
+    static rational_point_t make(int128_t nx, int128_t ny, std::int64_t d) {
+      return { nx, ny, d, float_t(nx) / float_t(d) };
+    }
+
+    /**
+     * @brief Converts a point with integer coordinates
+     *
+     * @param pt The point
+     * @return `rational_point_t` The same point with denominator `1`
+     */
+    template <typename Int>
+    static rational_point_t from(const ipoint_t<Int> &pt) { return { pt.x, pt.y, 1, float_t(pt.x) }; }
+
+    /**
+     * @brief A point to the right of every other, i.e. with an infinite x coordinate
+     *
+     * @return `rational_point_t` A point which compares greater than every finite point
+     */
+    static rational_point_t infinity() { return { 1, 0, 0, std::numeric_limits<float_t>::infinity() }; }
+
+    /**
+     * @brief Compares the x coordinates of two points
+     *
+     * @param other The other point
+     * @return `-1`, `0` or `+1` as the x coordinate is lesser than, equal to or greater than that of \a other
+     */
+    int compare_x(const rational_point_t &other) const {
+      // each rounded coordinate is within two rounding errors of the exact one
+      if(std::fabs(x_approx - other.x_approx) > 0x1p-50 * (std::fabs(x_approx) + std::fabs(other.x_approx)))
+        return x_approx < other.x_approx? -1 : +1;
+
+      return d == other.d? detail::sign(nx - other.nx) : detail::compare_products(nx, other.d, other.nx, d);
+    }
+
+    /**
+     * @brief Compares two points on the tuple `<x, y>`
+     *
+     * @param other The other point
+     * @return `-1`, `0` or `+1` as the point is lesser than, equal to or greater than \a other
+     */
+    int compare(const rational_point_t &other) const {
+      if(int cx = compare_x(other))
+        return cx;
+      return d == other.d? detail::sign(ny - other.ny) : detail::compare_products(ny, other.d, other.ny, d);
+    }
+
+    /**
+     * @brief Compares the x coordinate of the point with an integer
+     *
+     * @param x The integer
+     * @return `-1`, `0` or `+1` as the x coordinate is lesser than, equal to or greater than \a x
+     */
+    int compare_x(std::int64_t x) const { return detail::sign(nx - int128_t(x) * d); }
+
+    /**
+     * @brief Compares the y coordinate of the point with an integer
+     *
+     * @param y The integer
+     * @return `-1`, `0` or `+1` as the y coordinate is lesser than, equal to or greater than \a y
+     */
+    int compare_y(std::int64_t y) const { return detail::sign(ny - int128_t(y) * d); }
+
+    /// Compares exactly, unlike `point_t`
+    bool operator == (const rational_point_t &other) const { return compare(other) == 0; }
+
+    /// Lexicographic order on the tuple `<x, y>`
+    bool operator < (const rational_point_t &other) const { return compare(other) < 0; }
+
+    /// Checks whether the point is \a pt
+    template <typename Int>
+    bool operator == (const ipoint_t<Int> &pt) const { return compare_x(pt.x) == 0 and compare_y(pt.y) == 0; }
+
+    /**
+     * @brief Rounds the point to the nearest floating point coordinates
+     *
+     * @return `point_t` The point, with each coordinate within one rounding error
+     */
+    point_t approx() const {
+      return point_t{ float_t(nx) / float_t(d), float_t(ny) / float_t(d) };
+    }
+  };
+
+  /**
+   * @brief The line through an integer segment, as \f$ dx \cdot y = dy \cdot x + c \f$ with \f$ dx \ge 0 \f$
+   *
+   * Used by the exact sweep to compare segments without dividing.
+   */
+  struct exact_line_t {
+    /// The id of a line which stands for a point rather than a segment, see `probe()`
+    static constexpr size_t probe_id = std::numeric_limits<size_t>::max();
+
+    /// The constant term
+    int128_t c;
+
+    /// The (positive) horizontal extent of the segment
+    std::int64_t dx;
+
+    /// The vertical extent of the segment
+    std::int64_t dy;
+
+    /// The index of the segment in input
+    size_t seg_id;
+
+    /// The slope \f$ dy / dx \f$ rounded to floating point
+    float_t slope_approx;
+
+    /// The height at \f$ x = 0 \f$, \f$ c / dx \f$, rounded to floating point
+    float_t offset_approx;
+
+    /**
+     * @brief The line through a segment
+     *
+     * Vertical segments get \f$ dx = 0 \f$, for which only `meet()` is meaningful.
+     *
+     * @param seg The segment
+     * @return `exact_line_t` Its line, with the id of the segment
+     */
+    template <typename Int>
+    static exact_line_t through(const isegment_t<Int> &seg) {
+      std::int64_t dx = std::int64_t(seg.q.x) - seg.p.x, dy = std::int64_t(seg.q.y) - seg.p.y;
+      int128_t c = int128_t(seg.p.y) * dx - int128_t(dy) * seg.p.x;
+      return { c, dx, dy, seg.seg_id, dx? float_t(dy) / float_t(dx) : 0, dx? float_t(c) / float_t(dx) : 0 };
+    }
+
+    /**
+     * @brief A line which stands for the point the sweep is at, to search the lines through it by
+     *
+     * Only its id is looked at by the comparator, every other field is zero.
+     *
+     * @return `exact_line_t` The line with id `probe_id`
+     */
+    static exact_line_t probe() { return { 0, 0, 0, probe_id, 0, 0 }; }
+
+    /**
+     * @brief Tells on which side of the line a point lies
+     *
+     * @param pt The point
+     * @return `-1`, `0` or `+1` as the line passes below, through or above \a pt
+     */
+    int side(const rational_point_t &pt) const {
+      return detail::sign(dy * pt.nx + c * pt.d - pt.ny * dx);
+    }
+
+    /**
+     * @brief The point on the line with x coordinate \a x
+     *
+     * @param x The x coordinate
+     * @return `rational_point_t` The point
+     */
+    rational_point_t at(std::int64_t x) const { return rational_point_t::make(int128_t(x) * dx, int128_t(dy) * x + c, dx); }
+  };
+
+  /**
+   * @brief Compares the heights of two lines at the x coordinate of a point
+   *
+   * @param a The first line
+   * @param b The second line
+   * @param pt The point
+   * @return `-1`, `0` or `+1` as \a a passes below, through or above the point where \a b meets \f$ x = pt.x \f$
+   */
+  inline int compare_at(const exact_line_t &a, const exact_line_t &b, const rational_point_t &pt) {
+    // the heights in floating point are off by at most a few rounding errors of the terms they add up
+    float_t ya = a.slope_approx * pt.x_approx, yb = b.slope_approx * pt.x_approx;
+    float_t bound = 0x1p-49 * (std::fabs(ya) + std::fabs(a.offset_approx) + std::fabs(yb) + std::fabs(b.offset_approx));
+    ya += a.offset_approx, yb += b.offset_approx;
+    if(std::fabs(ya - yb) > bound)
+      return ya < yb? -1 : +1;
+
+    // both are scaled by pt.d, which is positive
+    return detail::compare_products(a.dy * pt.nx + a.c * pt.d, b.dx, b.dy * pt.nx + b.c * pt.d, a.dx);
+  }
+
+  /**
+   * @brief Compares the slopes of two lines
+   *
+   * @param a The first line
+   * @param b The second line
+   * @return `-1`, `0` or `+1` as the slope of \a a is lesser than, equal to or greater than that of \a b
+   */
+  inline int compare_slopes(const exact_line_t &a, const exact_line_t &b) {
+    return detail::sign(int128_t(a.dy) * b.dx - int128_t(b.dy) * a.dx);
+  }
+
+  /**
+   * @brief Computes the point where two lines meet
+   * @pre The lines must not be parallel.
+   *
+   * @param a The first line
+   * @param b The second line
+   * @return `rational_point_t` The point of intersection
+   */
+  inline rational_point_t meet(const exact_line_t &a, const exact_line_t &b) {
+    int128_t d = int128_t(b.dy) * a.dx - int128_t(a.dy) * b.dx;
+    int128_t nx = a.c * b.dx - b.c * a.dx;
+    int128_t ny = a.c * b.dy - b.c * a.dy;
+    return d > 0? rational_point_t::make(nx, ny, std::int64_t(d)) : rational_point_t::make(-nx, -ny, std::int64_t(-d));
+  }
+
+  /**
+   * @brief Computes the sign of the cross product of three points, exactly
+   *
+   * @param a The first point
+   * @param b The second point
+   * @param c The third point
+   * @return `-1` if the cross product is negative
+   * @return `0`  if the cross product is zero
+   * @return `+1` if the cross product is positive
+   */
+  template <typename Int>
+  int cross_prod(const ipoint_t<Int> &a, const ipoint_t<Int> &b, const ipoint_t<Int> &c) {
+    return detail::sign(int128_t(std::int64_t(b.x) - a.x) * (std::int64_t(c.y) - a.y)
+                          - int128_t(std::int64_t(b.y) - a.y) * (std::int64_t(c.x) - a.x));
+  }
+
+  /**
+   * @brief Checks if two integer segments intersect, exactly
+   *
+   * @param a The first segment
+   * @param b The second segment
+   * @return `true` if the segments share at least one point
+   * @return `false` otherwise
+   */
+  template <typename Int>
+  bool is_intersecting(const isegment_t<Int> &a, const isegment_t<Int> &b) {
+    auto overlap = [](Int l1, Int r1, Int l2, Int r2) {
+      if(l1 > r1) std::swap(l1, r1);
+      if(l2 > r2) std::swap(l2, r2);
+      return std::max(l1, l2) <= std::min(r1, r2);
+    };
+
+    return overlap(a.p.x, a.q.x, b.p.x, b.q.x)
+           and overlap(a.p.y, a.q.y, b.p.y, b.q.y)
+           and cross_prod(a.p, a.q, b.p) * cross_prod(a.p, a.q, b.q) <= 0
+           and cross_prod(b.p, b.q, a.p) * cross_prod(b.p, b.q, a.q) <= 0;
+  }
+
+  /**
+   * @brief Computes the point of intersection of two integer segments, exactly
+   * @pre The segments must intersect, and not overlap.
+   *
+   * @param a The first segment
+   * @param b The second segment
+   * @return `rational_point_t` The point of intersection, which is a shared end point if the segments are parallel
+   */
+  template <typename Int>
+  rational_point_t intersection_point(const isegment_t<Int> &a, const isegment_t<Int> &b) {
+    exact_line_t la = exact_line_t::through(a), lb = exact_line_t::through(b);
+
+    // parallel segments which intersect without overlapping only touch at an end point
+    if(compare_slopes(la, lb) == 0)
+      return rational_point_t::from(a.p == b.p or a.p == b.q? a.p : a.q);
+
+    return meet(la, lb);
+  }
+
+} // namespace geometry
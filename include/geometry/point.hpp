@@ -15,24 +15,35 @@ namespace geometry {
 
   /**
    * @brief Simple point struct to store the x and y coordinates of point entities
+   *
+   * @tparam T The scalar type of the coordinates, `float` or `double`
    */
-  struct point_t {
+  template <typename T>
+  struct basic_point {
     /// The x coordinate of the point
-    float_t x;
+    T x;
 
     /// The y coordinate of the point
-    float_t y;
+    T y;
 
     /**
-     * @brief Overloading the == operator for point_t
+     * @brief Overloading the == operator for basic_point
      *
-     * All floating point comparisons are done within a neighbourhood of `geometry::EPS`.
+     * All floating point comparisons are done within a neighbourhood of `geometry::tolerance<T>`.
      *
      * @param other The other point this is being compared to
-     * @return `true` if both the x and y coordinates match with max permissible error `geometry::EPS`
+     * @return `true` if both the x and y coordinates match with max permissible error `geometry::tolerance<T>`
      * @return `false` otherwise
      */
-    bool operator == (const point_t &other) const;
+    bool operator == (const basic_point &other) const;
   };
 
+  /// A point with `float_t` coordinates
+  using point_t = basic_point<float_t>;
+
+  /// \cond
+  extern template struct basic_point<float>;
+  extern template struct basic_point<double>;
+  /// \endcond
+
 } // namespace geometry
\ No newline at end of file
@@ -14,13 +14,16 @@ namespace geometry {
   /**
    * @brief Segment struct which encapsulates information about a segment
    * @warning \f$ p \le q \f$ must hold for the algorithm to work (comparing on the tuple `<x, y>`)
+   *
+   * @tparam T The scalar type of the coordinates, `float` or `double`
    */
-  struct segment_t {
+  template <typename T>
+  struct basic_segment {
     /// The point where the segment begins
-    point_t p;
+    basic_point<T> p;
 
     /// The point where the segment ends
-    point_t q;
+    basic_point<T> q;
 
     /// The index of the segment in input
     size_t seg_id;
@@ -31,24 +34,25 @@ namespace geometry {
      * @param x The x coordinate of the point to be found on the segment
      * @return `y` The corresponding y coordinate of the desired point
      */
-    float_t eval_y(float_t x) const;
+    T eval_y(T x) const;
 
     /**
-     * @brief  Overloading the < operator overload for segment_t
-     *
-     * Required by (`std::less<T>`, the defalt comparator of) the segment ordering BBST
-     * to make comparisons between events and establish an ordering.
-     *
-     * Compares y coordinates of segments by calling `segment_t::eval_y()` with the current x coordinate of the sweepline. <br>
-     * All floating point comparisons are done within a neighbourhood of `geometry::EPS`.
+     * @brief Computes the slope of the segment
      *
-     * @param s The other segment to compare to
-     * @return `true` if the y coordinate corresponding to `sweepline::sweeplineX` is lesser than the other segment's
-     * @return `false` otherwise
+     * @return `dy / dx` The slope of the segment
+     * @return `-inf` if the segment is vertical, or a single point used as a search key
      */
-    bool operator < (const segment_t &s) const;
+    T slope() const;
   };
 
+  /// A segment with `float_t` coordinates
+  using segment_t = basic_segment<float_t>;
+
+  /// \cond
+  extern template struct basic_segment<float>;
+  extern template struct basic_segment<double>;
+  /// \endcond
+
   /**
    * @brief Checks if two segments intersect in one dimension
    *
@@ -59,7 +63,8 @@ namespace geometry {
    * @return `true` if the segments intersect in one dimension
    * @return `false` otherwise
    */
-  bool can_intersect_1d(float_t l1, float_t r1, float_t l2, float_t r2);
+  template <typename T>
+  bool can_intersect_1d(T l1, T r1, T l2, T r2);
 
   /**
    * @brief Computes the sign of the cross product of three points
@@ -71,7 +76,8 @@ namespace geometry {
    * @return `0`  if the cross product is zero
    * @return `+1` if the cross product is positive
    */
-  int cross_prod(const point_t &a, const point_t &b, const point_t &c);
+  template <typename T>
+  int cross_prod(const basic_point<T> &a, const basic_point<T> &b, const basic_point<T> &c);
 
   /**
    * @brief Checks if two segments intersect
@@ -86,7 +92,8 @@ namespace geometry {
    * @return `true` if the segments intersect
    * @return `false` otherwise
    */
-  bool is_intersecting(const segment_t &a, const segment_t &b);
+  template <typename T>
+  bool is_intersecting(const basic_segment<T> &a, const basic_segment<T> &b);
 
   /**
    * @brief Computes the point of intersection of two segments
@@ -96,6 +103,7 @@ namespace geometry {
    * @param b The second segment
    * @return The point of intersection of the two segments
    */
-  point_t intersection_point(const segment_t &a, const segment_t &b);
+  template <typename T>
+  basic_point<T> intersection_point(const basic_segment<T> &a, const basic_segment<T> &b);
 
 } // namespace geometry
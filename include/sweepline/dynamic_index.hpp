@@ -0,0 +1,137 @@
+/**
+ * @file dynamic_index.hpp
+ * @author the-hyp0cr1t3
+ * @brief Describes an index of intersecting segments which is kept up to date as segments are inserted and erased
+ * @date 2026-10-17
+ */
+#pragma once
+
+#include <sweepline.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace sweepline {
+
+  /**
+   * @brief An index of line segments and the intersections among them, for sets which change a few segments at a time
+   *
+   * Segments are bucketed in a uniform grid, so inserting or erasing a segment only compares it
+   * against the segments sharing a cell with it, and every intersection it takes part in is
+   * stored with both of its segments. The initial set is indexed with a single sweep.
+   *
+   * Changes are reported per pair of segments, as an `intersection_t` whose two ids are in increasing order.
+   *
+   * @code
+   * sweepline::dynamic_index index(line_segments);
+   * auto gained = index.insert(new_segment);   // intersections of new_segment with the rest
+   * auto lost = index.erase(old_id);           // intersections old_id used to take part in
+   * @endcode
+   */
+  class dynamic_index {
+    /// A segment in the index, with the segments it intersects and where
+    struct entry {
+      geometry::segment_t seg;                                        ///< The segment
+      std::vector<std::pair<size_t, geometry::point_t>> crossings;   ///< The ids of the segments it intersects, with the points of intersection
+    };
+
+    geometry::float_t cell_size;                                  ///< The side of a grid cell
+    std::unordered_map<size_t, entry> entries;                    ///< The segments in the index by id
+    std::unordered_map<std::uint64_t, std::vector<size_t>> cells; ///< The ids of the segments overlapping each non-empty grid cell
+
+    /**
+     * @brief Calls \a f with the key of every grid cell \a seg passes through, widened by `geometry::EPS`
+     *
+     * Walks the columns of the grid from `seg.p` to `seg.q`, and within each the rows the segment spans there,
+     * so a segment crossing \f$ k \f$ cells visits \f$ O(k) \f$ of them rather than its whole bounding box.
+     *
+     * @param seg The segment
+     * @param f The function to call
+     */
+    template <typename Function>
+    void for_each_cell(const geometry::segment_t &seg, Function &&f) const;
+
+    /**
+     * @brief Finds where two intersecting segments meet, preferring an end point which lies on the other segment
+     *
+     * @param a The first segment
+     * @param b The second segment
+     * @return `geometry::point_t` The point of intersection, as the sweep would report it
+     */
+    static geometry::point_t meeting_point(const geometry::segment_t &a, const geometry::segment_t &b);
+
+  public:
+
+    /**
+     * @brief Constructor for an empty index
+     *
+     * @throws std::invalid_argument if \a cell_size is not positive and finite
+     *
+     * @param cell_size The side of a grid cell, about the typical extent of a segment works well
+     */
+    explicit dynamic_index(geometry::float_t cell_size);
+
+    /**
+     * @brief Constructor, indexes the segments and their intersections with one call to `find_intersections()`
+     * @pre \f$ p \le q \f$ must hold for each line segment in the list.
+     * @pre No two line segments should coincide with each other either fully or partially.
+     *
+     * The cell size is the average extent of the segments.
+     *
+     * @param line_segments The initial line segments, ids must be unique but need not match their position
+     */
+    explicit dynamic_index(const std::vector<geometry::segment_t> &line_segments);
+
+    /**
+     * @brief Gets the number of segments in the index
+     *
+     * @return `size_t` The number of segments
+     */
+    size_t size() const { return entries.size(); }
+
+    /**
+     * @brief Checks whether a segment is in the index
+     *
+     * @param seg_id The id of the segment
+     * @return `true` if a segment with id \a seg_id is in the index
+     * @return `false` otherwise
+     */
+    bool contains(size_t seg_id) const { return entries.count(seg_id); }
+
+    /**
+     * @brief Adds a segment to the index
+     * @pre \f$ p \le q \f$ must hold, and \a seg must not coincide with a segment in the index.
+     * @throws std::invalid_argument if a segment with the same id is already in the index
+     *
+     * @param seg The segment to add, identified by `seg.seg_id`
+     * @return `std::vector<intersection_t>` The intersections gained, one for every segment \a seg intersects
+     */
+    std::vector<intersection_t> insert(const geometry::segment_t &seg);
+
+    /**
+     * @brief Removes a segment from the index
+     *
+     * @param seg_id The id of the segment to remove
+     * @return `std::vector<intersection_t>` The intersections lost, one for every segment it intersected,
+     * none if it was not in the index
+     */
+    std::vector<intersection_t> erase(size_t seg_id);
+
+    /**
+     * @brief Gets all intersections among the segments in the index
+     *
+     * Pairs meeting at the same point are merged by `merge_intersection_points()`,
+     * so the result matches that of `find_intersections()` on the same segments.
+     *
+     * @return `std::vector<intersection_t>` A list of all intersections
+     */
+    std::vector<intersection_t> intersections() const;
+
+    /// @return `size_t` The number of grid cells overlapped by some segment in the index, for tests and benchmarks
+    size_t num_cells() const { return cells.size(); }
+  };
+
+} // namespace sweepline
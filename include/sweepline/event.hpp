@@ -8,26 +8,39 @@
 
 #include <point.hpp>
 
+#include <cmath>
+#include <cstdint>
+
 
 namespace sweepline {
 
+  /**
+   * @brief The type of an event, shared by events of every scalar type
+   */
+  struct event_type {
+    /// An enum for the type of event
+    enum type {
+      begin,    ///< denotes when a segment starts
+      interior, ///< denotes an interior point of a segment
+      end       ///< denotes when a segment ends
+    };
+  };
+
   /**
    * @brief Event struct which encapsulates information about an event
    *
    * @note Multiple events having the same event point may exist simultaneously
    * within the event queue, one for each segment containing its `seg_id`.
    *
+   * @tparam T The scalar type of the coordinates, `float` or `double`
    */
-  struct event_t {
+  template <typename T>
+  struct basic_event : event_type {
     /// The point where the event occurs
-    geometry::point_t p;
+    geometry::basic_point<T> p;
 
-    /// An enum for the type of event
-    enum type {
-      begin,    ///< denotes when a segment starts
-      interior, ///< denotes an interior point of a segment
-      end       ///< denotes when a segment ends
-    } tp;   ///< The type of the event
+    /// The type of the event
+    type tp;
 
     /// The id of the segment
     size_t seg_id;
@@ -35,7 +48,7 @@ namespace sweepline {
     /**
      * @brief Default constructor
      */
-    event_t() = default;
+    basic_event() = default;
 
     /**
      * @brief Parameterized constructor
@@ -44,24 +57,55 @@ namespace sweepline {
      * @param tp The type of the event
      * @param seg_id The id of the segment
      */
-    event_t(const geometry::point_t &p, type tp, size_t seg_id)
+    basic_event(const geometry::basic_point<T> &p, type tp, size_t seg_id)
       : p(p), tp(tp), seg_id(seg_id) {}
 
     /**
-     * @brief Overloading the < operator for event_t
+     * @brief Overloading the < operator for basic_event
      *
-     * Required by (`std::less<T>`, the defalt comparator of) the event queue BBST
-     * to make comparisons between events and establish an ordering.
+     * Required by (`std::less<T>`, the defalt comparator of) the event queue BBST, and by the heaps of `event_queue.hpp`,
+     * to make comparisons between events and establish an ordering. Defined in the header so that those may inline it.
      *
      * Compares on, in decreasing priority, the tuple `<p.x, p.y, p.seg_id>`. <br>
-     * All floating point comparisons are done within a neighbourhood of `geometry::EPS`.
+     * All floating point comparisons are done within a neighbourhood of `geometry::tolerance<T>`.
      *
      * @param e The other event to be compared to
      * @return `true` if it compares less than the other event
      * @return `false` otherwise
      */
-    bool operator < (const event_t &e) const;
+    bool operator < (const basic_event &e) const {
+      if(std::fabs(p.x - e.p.x) > geometry::tolerance<T>)
+        return p.x < e.p.x;
+      else if(std::fabs(p.y - e.p.y) > geometry::tolerance<T>)
+        return p.y < e.p.y;
+      else
+        return seg_id < e.seg_id;
+    }
 
   };
 
+  /// An event at a point with `geometry::float_t` coordinates
+  using event_t = basic_event<geometry::float_t>;
+
+  /**
+   * @brief A begin or end event known before the sweep starts, packed into 16 bytes
+   *
+   * Only the x coordinate of the event is kept, as a key which sorts like an unsigned integer (see `radix_key()`),
+   * since its point is that of its segment at that x.
+   */
+  struct endpoint_event {
+    std::uint64_t key;        ///< The x coordinate of the event, as mapped by `radix_key()`
+    std::uint32_t seg_id;     ///< The id of the segment
+    event_type::type tp;      ///< The type of the event, `event_type::type::begin` or `event_type::type::end`
+  };
+
+  /// \cond
+  static_assert(sizeof(endpoint_event) == 16, "endpoint events are meant to be packed into 16 bytes");
+  /// \endcond
+
+  /// \cond
+  extern template struct basic_event<float>;
+  extern template struct basic_event<double>;
+  /// \endcond
+
 } // namespace sweepline
\ No newline at end of file
@@ -0,0 +1,372 @@
+/**
+ * @file event_queue.hpp
+ * @author the-hyp0cr1t3
+ * @brief Describes the priority queues the sweep may keep its events in
+ * @date 2026-10-17
+ */
+#pragma once
+
+#include <red_black_tree.tpp>
+#include <event.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace sweepline {
+
+  template <typename T, typename Compare = std::less<T>>
+  using bbst = BBST::red_black_tree<T, Compare>;   ///< Type alias for the underlying BBST used. Works with std::set in exactly the same way as well.
+  // using bbst = std::set<T, Compare>; // works with std::set in exactly the same way (don't forget to #include <set>)
+
+  /**
+   * @brief An event queue backed by a BBST, ordered by `basic_event::operator<()`
+   *
+   * Events which compare equal are kept only once, the first to be pushed.
+   *
+   * @tparam Event The type of the events
+   */
+  template <typename Event>
+  class bbst_event_queue {
+    bbst<Event> events;   ///< The events, in order
+
+  public:
+
+    /// @return `true` if there are no events
+    bool empty() const { return events.empty(); }
+
+    /// @return `size_t` The number of events
+    size_t size() const { return events.size(); }
+
+    /// @return `const Event &` The least event
+    const Event &top() const { return *events.begin(); }
+
+    /**
+     * @brief Adds an event
+     *
+     * @param e The event
+     */
+    void push(const Event &e) { events.insert(e); }
+
+    /// @brief Removes the least event
+    void pop() { events.erase(events.begin()); }
+
+    /// @brief Removes all events
+    void clear() {
+      while(!events.empty())
+        events.erase(events.begin());
+    }
+
+    /**
+     * @brief Calls \a fn on every event, in order
+     *
+     * @param fn The callable
+     */
+    template <typename Fn>
+    void for_each(Fn &&fn) const {
+      for(auto &e: events)
+        fn(e);
+    }
+  };
+
+  /**
+   * @brief An event queue backed by a d-ary min-heap laid out in a single array
+   *
+   * Unlike `bbst_event_queue`, events which compare equal are all kept, so the same event may be popped more than once.
+   * Pushing and popping allocate nothing once the array has grown large enough, and `heap_event_queue::clear()` keeps it.
+   * A greater \a Arity makes the heap shallower at the cost of more comparisons per level on pop.
+   *
+   * @tparam Event The type of the events
+   * @tparam Arity The number of children of every node
+   */
+  template <typename Event, size_t Arity = 4>
+  class heap_event_queue {
+    static_assert(Arity >= 2, "a heap needs at least two children per node");
+
+    std::vector<Event> heap;   ///< The events, every one no greater than its children `Arity * i + 1, ..., Arity * i + Arity`
+
+  public:
+
+    /// @return `true` if there are no events
+    bool empty() const { return heap.empty(); }
+
+    /// @return `size_t` The number of events
+    size_t size() const { return heap.size(); }
+
+    /// @return `const Event &` The least event
+    const Event &top() const { return heap.front(); }
+
+    /**
+     * @brief Adds an event
+     *
+     * @param e The event
+     */
+    void push(const Event &e) {
+      size_t i = heap.size();
+      heap.push_back(e);
+
+      // move greater parents down into the hole until e fits
+      while(i > 0) {
+        size_t parent = (i - 1) / Arity;
+        if(!(e < heap[parent]))
+          break;
+        heap[i] = heap[parent];
+        i = parent;
+      }
+      heap[i] = e;
+    }
+
+    /// @brief Removes the least event
+    void pop() {
+      Event last = heap.back();
+      heap.pop_back();
+      if(heap.empty())
+        return;
+
+      // move lesser children up into the hole until the last event fits
+      size_t i = 0, n = heap.size();
+      for(size_t first; (first = Arity * i + 1) < n; ) {
+        size_t least = first;
+        for(size_t c = first + 1; c < std::min(first + Arity, n); c++)
+          if(heap[c] < heap[least])
+            least = c;
+
+        if(!(heap[least] < last))
+          break;
+        heap[i] = heap[least];
+        i = least;
+      }
+      heap[i] = last;
+    }
+
+    /// @brief Removes all events, keeping the memory allocated
+    void clear() { heap.clear(); }
+
+    /**
+     * @brief Calls \a fn on every event, in no particular order
+     *
+     * @param fn The callable
+     */
+    template <typename Fn>
+    void for_each(Fn &&fn) const {
+      for(auto &e: heap)
+        fn(e);
+    }
+  };
+
+  /**
+   * @brief Maps a coordinate to an unsigned integer, such that lesser coordinates map to lesser integers
+   *
+   * @param x The coordinate, `float` or `double`
+   * @return `std::uint64_t` The key
+   */
+  template <typename T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+  std::uint64_t radix_key(T x) {
+    static_assert(sizeof(T) == 4 or sizeof(T) == 8, "only float and double are supported");
+    using bits_t = std::conditional_t<sizeof(T) == 8, std::uint64_t, std::uint32_t>;
+    constexpr bits_t sign = bits_t(1) << (8 * sizeof(T) - 1);
+
+    bits_t bits;
+    std::memcpy(&bits, &x, sizeof(T));
+
+    // negative numbers grow more negative as their bits grow, so they are flipped below the positive ones
+    return bits & sign? bits_t(~bits) : bits_t(bits | sign);
+  }
+
+  /**
+   * @brief The inverse of `radix_key()`
+   *
+   * @param key The key
+   * @return `T` The coordinate which maps to \a key
+   */
+  template <typename T>
+  T from_radix_key(std::uint64_t key) {
+    using bits_t = std::conditional_t<sizeof(T) == 8, std::uint64_t, std::uint32_t>;
+    constexpr bits_t sign = bits_t(1) << (8 * sizeof(T) - 1);
+
+    bits_t bits = bits_t(key);
+    bits = bits & sign? bits_t(bits & ~sign) : bits_t(~bits);
+
+    T x;
+    std::memcpy(&x, &bits, sizeof(T));
+    return x;
+  }
+
+  /**
+   * @brief Maps the x coordinate of an event to an unsigned integer, such that lesser x maps to a lesser integer
+   *
+   * Used as the key of `radix_event_queue`.
+   *
+   * @param e The event
+   * @return `std::uint64_t` The key
+   */
+  template <typename T>
+  std::uint64_t radix_key(const basic_event<T> &e) {
+    return radix_key(e.p.x);
+  }
+
+  /**
+   * @brief Sorts endpoint events by key, and those with equal keys by id, in place
+   *
+   * A most significant digit first radix sort, which takes no memory beyond that of the events themselves.
+   * The events are partitioned in place by the 16 bits of their keys just below those every key shares,
+   * e.g. the sign and exponent of coordinates of similar magnitude, and each part is then sorted on its own,
+   * within the cache.
+   *
+   * @param events The events to sort
+   */
+  inline void radix_sort(std::vector<endpoint_event> &events) {
+    auto by_key = [](const endpoint_event &a, const endpoint_event &b) {
+      return a.key != b.key? a.key < b.key : a.seg_id != b.seg_id? a.seg_id < b.seg_id : a.tp < b.tp;
+    };
+
+    std::uint64_t lo = ~std::uint64_t(0), hi = 0;
+    for(auto &e: events)
+      lo = std::min(lo, e.key), hi = std::max(hi, e.key);
+
+    // too few events, or keys too close together, to be worth partitioning
+    constexpr size_t digit_bits = 16, num_parts = size_t(1) << digit_bits;
+    if(events.size() < 4 * num_parts or hi - lo < num_parts) {
+      std::sort(events.begin(), events.end(), by_key);
+      return;
+    }
+
+    size_t shift = 64 - __builtin_clzll(lo ^ hi) - digit_bits;
+    auto digit = [shift](const endpoint_event &e) { return (e.key >> shift) & (num_parts - 1); };
+
+    std::vector<size_t> begin(num_parts + 1, 0);
+    for(auto &e: events)
+      begin[digit(e) + 1]++;
+    for(size_t d = 0; d < num_parts; d++)
+      begin[d + 1] += begin[d];
+
+    // swap every event into its part, filling the parts from the front
+    std::vector<size_t> next(begin.begin(), begin.end() - 1);
+    for(size_t d = 0; d < num_parts; d++)
+      while(next[d] < begin[d + 1]) {
+        size_t to = digit(events[next[d]]);
+        if(to == d)
+          next[d]++;
+        else
+          std::swap(events[next[d]], events[next[to]++]);
+      }
+
+    for(size_t d = 0; d < num_parts; d++)
+      std::sort(events.begin() + begin[d], events.begin() + begin[d + 1], by_key);
+  }
+
+  /**
+   * @brief An event queue backed by a radix heap on the integer key `radix_key()`, for monotone use
+   *
+   * Events are bucketed by the highest bit in which their key differs from that of the last event popped,
+   * so an event moves to a lower bucket at most once for every bit of its key, and pushing takes constant time.
+   * Events whose keys equal that of the last event popped are kept in the lowest bucket, as a binary heap
+   * ordered by `basic_event::operator<()`.
+   *
+   * Meant for the sweep, which only ever pushes events past the sweepline. An event pushed with a key less
+   * than that of the last event popped is treated as if it had that key, i.e. it is popped next.
+   * As with `heap_event_queue`, events which compare equal are all kept.
+   *
+   * @tparam Event The type of the events, for which `radix_key()` must be defined
+   */
+  template <typename Event>
+  class radix_event_queue {
+    std::array<std::vector<Event>, 65> buckets;   ///< `buckets[i]` holds the events whose keys differ from `last` in bit `i - 1` at most
+    std::uint64_t last { 0 };                     ///< The key of the last event popped, or of the least event in `buckets[1...]` once `buckets[0]` runs out
+    size_t sz { 0 };                              ///< The number of events
+
+    /// @return `size_t` The bucket of an event with key \a key
+    size_t bucket_of(std::uint64_t key) const {
+      return key <= last? 0 : 64 - __builtin_clzll(key ^ last);
+    }
+
+    /// Orders the lowest bucket as a min-heap
+    static bool later(const Event &a, const Event &b) { return b < a; }
+
+    /// @brief Refills the empty lowest bucket from the lowest non-empty bucket, whose least key becomes `last`
+    void refill() {
+      size_t i = 1;
+      while(buckets[i].empty())
+        i++;
+
+      last = radix_key(buckets[i].front());
+      for(auto &e: buckets[i])
+        last = std::min(last, radix_key(e));
+
+      // every event moves to a lower bucket, since its key agrees with the new last above bit i - 1
+      for(auto &e: buckets[i])
+        buckets[bucket_of(radix_key(e))].push_back(e);
+      buckets[i].clear();
+
+      std::make_heap(buckets[0].begin(), buckets[0].end(), later);
+    }
+
+  public:
+
+    /// @return `true` if there are no events
+    bool empty() const { return sz == 0; }
+
+    /// @return `size_t` The number of events
+    size_t size() const { return sz; }
+
+    /// @return `const Event &` The least event
+    const Event &top() const { return buckets[0].front(); }
+
+    /**
+     * @brief Adds an event
+     *
+     * @param e The event
+     */
+    void push(const Event &e) {
+      std::uint64_t key = radix_key(e);
+      if(sz++ == 0)
+        last = key;
+
+      size_t b = bucket_of(key);
+      buckets[b].push_back(e);
+      if(b == 0)
+        std::push_heap(buckets[0].begin(), buckets[0].end(), later);
+    }
+
+    /// @brief Removes the least event
+    void pop() {
+      std::pop_heap(buckets[0].begin(), buckets[0].end(), later);
+      buckets[0].pop_back();
+
+      if(--sz and buckets[0].empty())
+        refill();
+    }
+
+    /// @brief Removes all events, keeping the memory allocated
+    void clear() {
+      for(auto &b: buckets)
+        b.clear();
+      sz = 0;
+    }
+
+    /**
+     * @brief Calls \a fn on every event, in no particular order
+     *
+     * @param fn The callable
+     */
+    template <typename Fn>
+    void for_each(Fn &&fn) const {
+      for(auto &b: buckets)
+        for(auto &e: b)
+          fn(e);
+    }
+  };
+
+  /// The event queue the solver uses unless told otherwise, any of the above may be swapped in
+  template <typename Event>
+  using default_event_queue = heap_event_queue<Event>;
+  // using default_event_queue = bbst_event_queue<Event>;
+  // using default_event_queue = radix_event_queue<Event>;
+
+} // namespace sweepline
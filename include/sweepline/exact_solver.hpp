@@ -0,0 +1,270 @@
+/**
+ * @file exact_solver.hpp
+ * @author the-hyp0cr1t3
+ * @brief Exact sweep over segments with integer coordinates
+ * @date 2026-10-17
+ */
+#pragma once
+
+#include <sweepline.hpp>
+#include <exact.hpp>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+
+namespace sweepline {
+
+  /**
+   * @brief An intersection of two or more integer segments, at its exact point
+   */
+  struct exact_intersection_t {
+    geometry::rational_point_t pt;   ///< The exact point of intersection of some segments
+    std::vector<size_t> segments;    ///< A list of segments (their ids) which intersect at this point
+  };
+
+  /// A callback which receives each exact intersection as soon as it is final
+  using exact_intersection_sink = std::function<void(exact_intersection_t &&)>;
+
+  /**
+   * @brief Event struct of the exact sweep, same as `event_t` at an exact point
+   */
+  struct exact_event_t {
+    geometry::rational_point_t p;   ///< The point where the event occurs
+    event_t::type tp;               ///< The type of the event
+    size_t seg_id;                  ///< The id of the segment
+
+    /**
+     * @brief Compares on, in decreasing priority, the tuple `<p.x, p.y, tp, seg_id>`, exactly
+     *
+     * @param e The other event to be compared to
+     * @return `true` if it compares less than the other event
+     * @return `false` otherwise
+     */
+    bool operator < (const exact_event_t &e) const {
+      if(int c = p.compare(e.p))
+        return c < 0;
+      return tp != e.tp? tp < e.tp : seg_id < e.seg_id;
+    }
+  };
+
+  /**
+   * @brief Compare functor for the segment ordering BBST of the exact sweep
+   *
+   * Bound to the point of the `exact_solver` which owns the BBST. Events are processed in order of
+   * `<x, y>`, so the sweepline is thought of as turned very slightly clockwise, through that point.
+   * Segments which meet on the sweepline are hence ordered as they are just past it if they meet
+   * at or below the point, and as they are just before it if they meet above, where they have yet to cross.
+   *
+   * A line with id `probe_id`, as made by `geometry::exact_line_t::probe()`, stands for the point itself,
+   * which compares less than every segment through it.
+   */
+  struct exact_segment_comparator {
+    /// The id of a line which stands for the point of the sweep
+    static constexpr size_t probe_id = geometry::exact_line_t::probe_id;
+
+    /// A pointer to the point the sweep is at
+    const geometry::rational_point_t *sweep_pt { nullptr };
+
+    /**
+     * @brief Compares two segments, or a segment and the point of the sweep
+     *
+     * @param a The line through the first segment
+     * @param b The line through the second segment
+     * @return `true` if \a a lies below \a b on the sweepline
+     * @return `false` otherwise
+     */
+    bool operator () (const geometry::exact_line_t &a, const geometry::exact_line_t &b) const;
+  };
+
+  /**
+   * @brief Finds all intersections among segments with integer coordinates, exactly
+   *
+   * Runs the same sweep as `solver`, with every predicate evaluated exactly on 64 and 128 bit integers
+   * and intersection points kept as `geometry::rational_point_t`. Unlike `solver`, there is no tolerance
+   * anywhere, so intersections are found however close they lie to each other or to other segments,
+   * and points are merged only if they are equal.
+   *
+   * @tparam Int The signed integer coordinate type, `std::int32_t` or `std::int64_t`
+   */
+  template <typename Int>
+  class exact_solver {
+    std::vector<geometry::isegment_t<Int>> line_segments;   ///< The list of input line segments
+    std::vector<geometry::exact_line_t> lines;              ///< The lines through the input line segments, by id
+
+    /// An intersection found during the sweep, whose segments are the ids in `[first, last)` of a separate list
+    struct found_t {
+      geometry::rational_point_t pt;    ///< The point of intersection
+      size_t first;                     ///< The index of the first segment id
+      size_t last;                      ///< The index past the last segment id
+    };
+
+    const exact_intersection_sink *sink { nullptr };          ///< The sink receiving intersections during `exact_solver::solve()`, none while counting
+    intersection_count counts { 0, 0 };                       ///< The intersections counted so far by `exact_solver::count()`
+    std::vector<found_t> pending;                             ///< Intersections on the sweepline, which may still be merged with ones yet to be found
+    std::vector<size_t> pending_ids;                          ///< The segments of the pending intersections
+    geometry::rational_point_t pending_min { geometry::rational_point_t::infinity() };  ///< The pending intersection with the least x coordinate
+    std::vector<found_t> vertical_intersections;              ///< Intersections between vertical segments, sorted by point
+    std::vector<size_t> vertical_ids;                         ///< The segments of the intersections between vertical segments
+
+    geometry::rational_point_t sweep_pt;                      ///< The point the sweep is at
+
+    bbst<exact_event_t> event_queue;                          ///< The event queue, implemented as a BBST of events
+    bbst<geometry::exact_line_t, exact_segment_comparator> seg_ordering { exact_segment_comparator{ &sweep_pt } };  ///< The status queue, or segment ordering, implemented as a BBST of lines
+    std::vector<geometry::isegment_t<Int>> vertical_segs;     ///< A list of vertical line segments that will be handled separately
+
+  public:
+
+    /**
+     * @brief Constructor
+     *
+     * @pre `line_segments[i].seg_id == i` must hold, since events refer to segments by their index.
+     * @throws std::out_of_range if a coordinate lies outside \f$ (-2^{30}, 2^{30}) \f$, i.e. `geometry::EXACT_COORD_LIMIT`
+     *
+     * @param line_segments The list of input line segments
+     */
+    explicit exact_solver(const std::vector<geometry::isegment_t<Int>> &line_segments);
+
+    /// \cond
+    // seg_ordering holds a pointer to sweep_pt, so a copy would compare against the wrong point
+    exact_solver(const exact_solver &) = delete;
+    exact_solver &operator = (const exact_solver &) = delete;
+    /// \endcond
+
+    /**
+     * @brief Finds which segments intersect at which points and returns all such intersections
+     * @pre \f$ p \le q \f$ must hold for each line segment in the list.
+     * @pre No two line segments should coincide with each other either fully or partially.
+     *
+     * @return `std::vector<exact_intersection_t>` A list of all intersections, sorted by point
+     */
+    std::vector<exact_intersection_t> solve();
+
+    /**
+     * @brief Finds all intersections like `exact_solver::solve()`, handing each one to \a sink as soon as it is final
+     *
+     * @param sink The callback receiving each intersection
+     */
+    void solve(const exact_intersection_sink &sink);
+
+    /**
+     * @brief Counts the intersections `exact_solver::solve()` would find, without building them
+     *
+     * @return `intersection_count` The number of intersection points and of intersecting pairs of segments
+     */
+    intersection_count count();
+
+  private:
+  // Implementation
+
+    /**
+     * @brief Runs the sweep, passing every intersection on to `exact_solver::sink`, or counting it if there is none
+     *
+     */
+    void sweep();
+
+    /**
+     * @brief Initializes the `exact_solver::event_queue` and `exact_solver::lines`, and populates `exact_solver::vertical_segs`
+     *
+     */
+    void init_event_queue();
+
+    /**
+     * @brief Finds intersections between pairs of vertical line segments, which may only touch at an end point
+     *
+     */
+    void find_vertical_vertical_intersections();
+
+    /**
+     * @brief Finds intersections between the vertical segments left of \a before and the non-vertical segments crossing them
+     *
+     * Runs once all events on the vertical segment have been processed, so it finds the segments passing through it,
+     * while those with an event on it were already found by `exact_solver::handle_event()`.
+     *
+     * @param before The point whose x coordinate the vertical segments must lie before
+     */
+    void find_vertical_nonvertical_intersections(const geometry::rational_point_t &before);
+
+    /**
+     * @brief Processes all events at \a cur
+     *
+     * Removes the segments through \a cur from `exact_solver::seg_ordering`, reports them together with
+     * \a begins and the vertical segments through \a cur if there are two or more, reinserts those which
+     * go on past \a cur along with \a begins, and schedules the crossings of the new neighbours.
+     *
+     * @param cur The point currently being processed
+     * @param begins The segments which begin at \a cur
+     */
+    void handle_event(const geometry::rational_point_t &cur, const std::vector<size_t> &begins);
+
+    /**
+     * @brief Schedules the intersection of two adjacent segments as an event if it lies past \a cur
+     *
+     * @param below The line through the lower of the two adjacent segments
+     * @param above The line through the upper of the two adjacent segments
+     * @param cur The point currently being processed
+     */
+    void find_new_event(const geometry::exact_line_t &below, const geometry::exact_line_t &above, const geometry::rational_point_t &cur);
+
+    /**
+     * @brief Merges pending intersections before the x coordinate of \a before and passes them on, or counts them
+     *
+     * @param before The point whose x coordinate pending intersections are passed on before
+     */
+    void flush_intersections(const geometry::rational_point_t &before);
+
+    /**
+     * @brief Adds an intersection at \a pt to the pending ones
+     *
+     * @param pt The point of intersection
+     * @param first The index in `exact_solver::pending_ids` of its first segment, the rest follow up to the end
+     */
+    void add_pending(const geometry::rational_point_t &pt, size_t first);
+
+    /// \cond
+    size_t vert_idx = 0;
+    size_t vert_vert_idx = 0;
+    std::vector<size_t> begins, through, merged_ids;
+    std::vector<exact_event_t> endpoints;
+    std::vector<typename bbst<geometry::exact_line_t, exact_segment_comparator>::node_type> through_nodes;
+    /// \endcond
+  };
+
+  /**
+   * @brief Finds all intersections among segments with integer coordinates, exactly
+   * @pre \f$ p \le q \f$ must hold for each line segment in the list.
+   * @pre No two line segments should coincide with each other either fully or partially.
+   *
+   * Same as `find_intersections()`, with no tolerance: segments are reported to intersect
+   * if and only if they share a point, and points are reported exactly.
+   *
+   * Calls `exact_solver::solve()` and returns the result.
+   *
+   * @tparam Int The signed integer coordinate type, `std::int32_t` or `std::int64_t`
+   * @param line_segments The list of input line segments, with coordinates within `geometry::EXACT_COORD_LIMIT`
+   * @return `std::vector<exact_intersection_t>` A list of all intersections, sorted by point
+   */
+  template <typename Int>
+  std::vector<exact_intersection_t> find_intersections(const std::vector<geometry::isegment_t<Int>> &line_segments);
+
+  /**
+   * @brief Counts the intersections the exact `find_intersections()` would return, without building them
+   *
+   * Calls `exact_solver::count()` and returns the result.
+   *
+   * @tparam Int The signed integer coordinate type, `std::int32_t` or `std::int64_t`
+   * @param line_segments The list of input line segments, with coordinates within `geometry::EXACT_COORD_LIMIT`
+   * @return `intersection_count` The number of intersection points and of intersecting pairs of segments
+   */
+  template <typename Int>
+  intersection_count count_intersections(const std::vector<geometry::isegment_t<Int>> &line_segments);
+
+  /// \cond
+  extern template class exact_solver<std::int32_t>;
+  extern template class exact_solver<std::int64_t>;
+  /// \endcond
+
+} // namespace sweepline
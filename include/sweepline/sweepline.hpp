@@ -6,28 +6,176 @@
  */
 #pragma once
 
-#include <red_black_tree.tpp>
 #include <point.hpp>
 #include <segment.hpp>
 #include <event.hpp>
+#include <event_queue.hpp>
 
 #include <vector>
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
 #include <utility>
+#include <functional>
+#include <optional>
+#include <type_traits>
 
 namespace sweepline {
 
-  /// A global variable which stores the current X coordinate of the vertical sweepline
-  extern geometry::float_t sweeplineX;
+  class thread_pool;
 
   /**
    * @brief Simple struct to bind together information on an intersection of two or more segments
+   *
+   * @tparam T The scalar type of the coordinates, `float` or `double`
    */
-  struct intersection_t {
-    geometry::point_t pt;   ///< The point of intersection of some segments
+  template <typename T>
+  struct basic_intersection {
+    geometry::basic_point<T> pt;    ///< The point of intersection of some segments
     std::vector<size_t> segments;   ///< A list of segments (their ids) which intersect at this point
   };
 
+  /// An intersection at a point with `geometry::float_t` coordinates
+  using intersection_t = basic_intersection<geometry::float_t>;
+
+  /// A callback which receives each intersection as soon as it is final
+  template <typename T>
+  using basic_intersection_sink = std::function<void(basic_intersection<T> &&)>;
+
+  /// A callback which receives each `intersection_t` as soon as it is final
+  using intersection_sink = basic_intersection_sink<geometry::float_t>;
+
+  /**
+   * @brief A list of intersections laid out flat, in compressed sparse row form
+   *
+   * The segments of `points[i]` are `ids[offsets[i]]` up to, but not including, `ids[offsets[i + 1]]`.
+   * The whole list takes three allocations rather than one per intersection, and a segment id takes 4 bytes rather than 8,
+   * so a point of \f$ m \f$ segments costs `sizeof(pt) + 4 (m + 1)` bytes.
+   *
+   * @tparam T The scalar type of the coordinates, `float` or `double`
+   */
+  template <typename T>
+  struct basic_intersection_list {
+    std::vector<geometry::basic_point<T>> points;   ///< The points of intersection, in the order `find_intersections()` returns them
+    std::vector<std::uint32_t> offsets { 0 };       ///< The index in `ids` of the first segment of each point, followed by `ids.size()`
+    std::vector<std::uint32_t> ids;                 ///< The segments (their ids) which intersect at each point, in increasing order
+
+    /// @brief Constructs an empty list
+    basic_intersection_list() = default;
+
+    /**
+     * @brief Constructs the list holding the same intersections as \a intersections, in the same order
+     *
+     * @param intersections The intersections
+     */
+    explicit basic_intersection_list(const std::vector<basic_intersection<T>> &intersections) {
+      points.reserve(intersections.size());
+      offsets.reserve(intersections.size() + 1);
+      for(auto &it: intersections)
+        push_back(it.pt, it.segments.begin(), it.segments.end());
+    }
+
+    /// @return `size_t` The number of intersections
+    size_t size() const { return points.size(); }
+
+    /// @return `true` if there are no intersections
+    bool empty() const { return points.empty(); }
+
+    /// @return `const std::uint32_t*` The first segment of the intersection at index \a i
+    const std::uint32_t *segments_begin(size_t i) const { return ids.data() + offsets[i]; }
+
+    /// @return `const std::uint32_t*` Past the last segment of the intersection at index \a i
+    const std::uint32_t *segments_end(size_t i) const { return ids.data() + offsets[i + 1]; }
+
+    /**
+     * @brief Builds the intersection at index \a i as a `basic_intersection`
+     *
+     * @param i The index
+     * @return `basic_intersection<T>` Its point and segments
+     */
+    basic_intersection<T> at(size_t i) const {
+      return { points[i], std::vector<size_t>(segments_begin(i), segments_end(i)) };
+    }
+
+    /**
+     * @brief Appends an intersection
+     *
+     * @param pt The point of intersection
+     * @param first The first of its segments
+     * @param last Past the last of its segments
+     * @throws std::length_error if the list would hold \f$ 2^{32} \f$ or more segment ids
+     */
+    template <typename Iterator>
+    void push_back(const geometry::basic_point<T> &pt, Iterator first, Iterator last) {
+      if(size_t(std::distance(first, last)) > std::numeric_limits<std::uint32_t>::max() - ids.size())
+        throw std::length_error("too many segment ids for the offsets of sweepline::basic_intersection_list");
+
+      points.push_back(pt);
+      for(; first != last; ++first)
+        ids.push_back(std::uint32_t(*first));
+      offsets.push_back(std::uint32_t(ids.size()));
+    }
+
+    /// @brief Removes all intersections, keeping the memory allocated
+    void clear() {
+      points.clear();
+      ids.clear();
+      offsets.assign(1, 0);
+    }
+  };
+
+  /// A list of intersections at points with `geometry::float_t` coordinates
+  using intersection_list = basic_intersection_list<geometry::float_t>;
+
+  /**
+   * @brief Simple struct to bind together the number of intersections, as counted by `count_intersections()`
+   */
+  struct intersection_count {
+    size_t num_points;  ///< The number of distinct intersection points, i.e. the size of the list `find_intersections()` returns
+    size_t num_pairs;   ///< The number of pairs of segments which intersect, \f$ \binom{m}{2} \f$ for a point with \f$ m \f$ segments
+  };
+
+  /**
+   * @brief Simple struct to bind together the number of intersection events a sweep saved, as reported by `basic_solver::event_counts()`
+   */
+  struct event_count {
+    size_t duplicate_pairs { 0 };   ///< The number of times a pair of segments became adjacent again and was not checked, or scheduled, again
+    size_t stale_events { 0 };      ///< The number of events dropped since their segments had stopped being adjacent, or as copies of queued ones
+    size_t shared_events { 0 };     ///< The number of events not pushed since their segment was already scheduled at the same point by its other neighbour
+    size_t max_queue_size { 0 };    ///< The most intersection events ever held by the event queue at once
+  };
+
+  /**
+   * @brief An axis aligned rectangle, which may be used to restrict the search for intersections to it
+   *
+   * @tparam T The scalar type of the coordinates, `float` or `double`
+   */
+  template <typename T>
+  struct basic_query_window {
+    geometry::basic_point<T> lo;   ///< The corner with the least x and y coordinates
+    geometry::basic_point<T> hi;   ///< The corner with the greatest x and y coordinates
+
+    /**
+     * @brief Checks whether a point lies in the window, boundary included (within `geometry::tolerance<T>`)
+     *
+     * @param pt The point
+     * @return `true` if \a pt lies in the window
+     * @return `false` otherwise
+     */
+    bool contains(const geometry::basic_point<T> &pt) const {
+      constexpr T eps = geometry::tolerance<T>;
+      return lo.x - eps <= pt.x and pt.x <= hi.x + eps
+        and lo.y - eps <= pt.y and pt.y <= hi.y + eps;
+    }
+  };
+
+  /// A query window with `geometry::float_t` coordinates
+  using query_window = basic_query_window<geometry::float_t>;
+
   /**
    * @brief Finds which segments intersect at which points and returns all such intersections
    * @pre \f$ p \le q \f$ must hold for each line segment in the list.
@@ -41,7 +189,7 @@ namespace sweepline {
    * Returns a list of intersections, i.e. pairs of points and the corresponding
    * indices (1-based) of segments which intersect at that point.
    *
-   * Calls `solver::solve()` and returns the result.
+   * Calls `basic_solver::solve()` and returns the result.
    *
    * @param line_segments The list of input line segments
    * @param verbose The `utils::args::verbose` flag
@@ -54,24 +202,518 @@ namespace sweepline {
     bool enable_color = true
   );
 
+  /**
+   * @brief Same as the above, for segments with `float` coordinates
+   *
+   * Events and segments take half the memory of their `double` counterparts, so the sweep moves half as many bytes.
+   * Computations are done in `float` with a tolerance of `geometry::tolerance<float>`, which suits
+   * coordinates of magnitude up to about \f$ 10^3 \f$.
+   *
+   * Calls `basic_solver<float>::solve()` and returns the result.
+   *
+   * @param line_segments The list of input line segments
+   * @param verbose The `utils::args::verbose` flag
+   * @param enable_color The `utils::args::enable_color` flag
+   * @return `std::vector<basic_intersection<float>>` A list of all intersections
+   */
+  std::vector<basic_intersection<float>> find_intersections(
+    const std::vector<geometry::basic_segment<float>> &line_segments,
+    bool verbose = false,
+    bool enable_color = true
+  );
+
+  /**
+   * @brief Finds the intersections which lie in \a window, ignoring the parts of the segments outside of it
+   * @pre \f$ p \le q \f$ must hold for each line segment in the list.
+   * @pre No two line segments should coincide with each other within the window either fully or partially.
+   *
+   * Segments which do not touch the window are dropped, and the rest are clipped to it, so the sweep only
+   * ever sees events within the window and its cost depends on the segments inside it rather than on all of them.
+   * The result is the same as that of `find_intersections()` with the points outside the window left out.
+   *
+   * The input is still copied and every segment tested against the window, so each query costs \f$ O(n) \f$
+   * on top of the sweep, however small the window; answering many queries over the same segments faster takes an index over them.
+   *
+   * Calls `basic_solver::solve()` on a `solver` restricted to the window and returns the result.
+   *
+   * @param line_segments The list of input line segments
+   * @param window The window to look for intersections in
+   * @return `std::vector<intersection_t>` A list of all intersections in the window
+   */
+  std::vector<intersection_t> find_intersections(
+    const std::vector<geometry::segment_t> &line_segments,
+    const query_window &window
+  );
+
+  /**
+   * @brief Same as `find_intersections()`, returning the intersections laid out flat in an `intersection_list`
+   * @pre \f$ p \le q \f$ must hold for each line segment in the list.
+   * @pre No two line segments should coincide with each other either fully or partially.
+   *
+   * The solver appends every intersection to the list as it becomes final, so no `intersection_t` is ever built.
+   *
+   * Calls `basic_solver::solve(basic_intersection_list<T>&)` and returns the result.
+   *
+   * @param line_segments The list of input line segments
+   * @param verbose The `utils::args::verbose` flag
+   * @param enable_color The `utils::args::enable_color` flag
+   * @return `intersection_list` All intersections, in the order `find_intersections()` returns them
+   */
+  intersection_list find_intersection_list(
+    const std::vector<geometry::segment_t> &line_segments,
+    bool verbose = false,
+    bool enable_color = true
+  );
+
+  /**
+   * @brief Counts the intersections `find_intersections()` would return, without building them
+   * @pre \f$ p \le q \f$ must hold for each line segment in the list.
+   * @pre No two line segments should coincide with each other either fully or partially.
+   *
+   * Points where several segments meet count once, exactly as in `find_intersections()`.
+   * No memory is allocated per intersection.
+   *
+   * Calls `basic_solver::count()` and returns the result.
+   *
+   * @param line_segments The list of input line segments
+   * @param verbose The `utils::args::verbose` flag
+   * @param enable_color The `utils::args::enable_color` flag
+   * @return `intersection_count` The number of intersection points and of intersecting pairs of segments
+   */
+  intersection_count count_intersections(
+    const std::vector<geometry::segment_t> &line_segments,
+    bool verbose = false,
+    bool enable_color = true
+  );
+
+  /**
+   * @brief Same as the above, for segments with `float` coordinates
+   *
+   * Calls `basic_solver<float>::count()` and returns the result.
+   *
+   * @param line_segments The list of input line segments
+   * @param verbose The `utils::args::verbose` flag
+   * @param enable_color The `utils::args::enable_color` flag
+   * @return `intersection_count` The number of intersection points and of intersecting pairs of segments
+   */
+  intersection_count count_intersections(
+    const std::vector<geometry::basic_segment<float>> &line_segments,
+    bool verbose = false,
+    bool enable_color = true
+  );
+
+  /**
+   * @brief Checks whether any two segments intersect, stopping at the first intersection found
+   * @pre \f$ p \le q \f$ must hold for each line segment in the list.
+   * @pre No two line segments should coincide with each other either fully or partially.
+   *
+   * Runs the same sweep as `find_intersections()` but stops as soon as two segments are seen to intersect,
+   * as in the Shamos-Hoey algorithm. Since no intersection events are processed before that, it takes
+   * \f$ \mathcal{O}(n logn) \f$ regardless of the number of intersections.
+   *
+   * Calls `basic_solver::any_intersection()` and returns the result.
+   *
+   * @param line_segments The list of input line segments
+   * @param verbose The `utils::args::verbose` flag
+   * @param enable_color The `utils::args::enable_color` flag
+   * @return `std::optional<intersection_t>` The point and the ids of two segments which intersect there, if any
+   */
+  std::optional<intersection_t> any_intersection(
+    const std::vector<geometry::segment_t> &line_segments,
+    bool verbose = false,
+    bool enable_color = true
+  );
+
+  /**
+   * @brief Finds all intersections like `find_intersections()`, splitting the work across several threads
+   * @pre \f$ p \le q \f$ must hold for each line segment in the list.
+   * @pre No two line segments should coincide with each other either fully or partially.
+   *
+   * Splits the x-range into vertical slabs carrying roughly the same amount of work, where every end point
+   * counts for one unit and every segment spreads one more unit evenly over its x-extent, so that inputs
+   * made only of long segments are split too. Boundaries are then moved into gaps between end points.
+   * Each slab is swept independently by a `solver` restricted to it on a `thread_pool`, with segments
+   * that cross a boundary clipped to the slab, appending to an `intersection_list` of its own.
+   * Every slab is swept in the `basic_frame` fitted to the whole input, in which boundaries and seams are laid out too,
+   * so the slabs compare within the same tolerance as a single sweep at any extent.
+   * The lists are then concatenated in order; only the intersections close to a boundary are passed
+   * through `merge_intersection_points()`, which removes those found by both slabs of the boundary.
+   *
+   * Falls back to `find_intersections()` if \a num_threads is 1 or the input cannot be split.
+   *
+   * @param line_segments The list of input line segments
+   * @param num_threads The number of threads to use, `0` picks `std::thread::hardware_concurrency()`
+   * @return `std::vector<intersection_t>` A list of all intersections, same as `find_intersections()`
+   */
+  std::vector<intersection_t> find_intersections_parallel(
+    const std::vector<geometry::segment_t> &line_segments,
+    size_t num_threads = 0
+  );
+
+  /**
+   * @brief Same as `find_intersections_parallel()`, returning the intersections laid out flat in an `intersection_list`
+   * @pre \f$ p \le q \f$ must hold for each line segment in the list.
+   * @pre No two line segments should coincide with each other either fully or partially.
+   *
+   * The slabs are concatenated into the list as they are, so no `intersection_t` is built
+   * but for those close to a slab boundary.
+   *
+   * Falls back to `find_intersection_list()` if \a num_threads is 1 or the input cannot be split.
+   *
+   * @param line_segments The list of input line segments
+   * @param num_threads The number of threads to use, `0` picks `std::thread::hardware_concurrency()`
+   * @return `intersection_list` All intersections, in the order `find_intersections_parallel()` returns them
+   */
+  intersection_list find_intersection_list_parallel(
+    const std::vector<geometry::segment_t> &line_segments,
+    size_t num_threads = 0
+  );
+
+  /**
+   * @brief Finds the intersections between two sets of segments, reporting only those which involve both sets
+   * @pre \f$ p \le q \f$ must hold for each line segment in either list.
+   * @pre No two line segments should coincide with each other either fully or partially.
+   *
+   * Segments are numbered by their position in \a red followed by \a blue, i.e. `blue[j]` has id `red.size() + j`.
+   * Points where segments of only one colour meet are left out, while those where both colours meet are
+   * reported with all their segments, exactly as in `find_intersections()`.
+   *
+   * Segments lying outside the bounding box of the other colour are dropped up front, and the sweep
+   * is restricted to the x-range shared by both colours, so crossings of a single colour outside
+   * of it never become events. Those within it are still swept to keep the segment ordering correct,
+   * but are never built into intersections.
+   *
+   * @param red The first list of line segments
+   * @param blue The second list of line segments
+   * @return `std::vector<intersection_t>` A list of all intersections which involve segments of both colours
+   */
+  std::vector<intersection_t> find_red_blue_intersections(
+    const std::vector<geometry::segment_t> &red,
+    const std::vector<geometry::segment_t> &blue
+  );
+
+  /**
+   * @brief Finds all intersections of many independent lists of line segments, spread across the workers of \a pool
+   * @pre \f$ p \le q \f$ must hold for each line segment in every list.
+   * @pre No two line segments in the same list should coincide with each other either fully or partially.
+   *
+   * Meant for many small instances, e.g. one per tile, where setting up a `solver` costs as much as running it.
+   * Every worker keeps a single `solver` which is `basic_solver::reset()` for each instance it picks up,
+   * and instances are handed out by the work-stealing `thread_pool`. Reusing the solvers pays off on instances
+   * of a few dozen segments or fewer; on hundreds of segments the sweep dominates and only the threads help.
+   *
+   * @param instances The lists of input line segments, segment ids are local to each list
+   * @param pool The thread pool to run on
+   * @return `std::vector<std::vector<intersection_t>>` The intersections of every instance, same as `find_intersections()`
+   */
+  std::vector<std::vector<intersection_t>> find_intersections_batch(
+    const std::vector<std::vector<geometry::segment_t>> &instances,
+    thread_pool &pool
+  );
+
+  /**
+   * @brief Same as the above, on a `thread_pool` of \a num_threads workers started for the call
+   *
+   * @param instances The lists of input line segments, segment ids are local to each list
+   * @param num_threads The number of threads to use, `0` picks `std::thread::hardware_concurrency()`
+   * @return `std::vector<std::vector<intersection_t>>` The intersections of every instance, same as `find_intersections()`
+   */
+  std::vector<std::vector<intersection_t>> find_intersections_batch(
+    const std::vector<std::vector<geometry::segment_t>> &instances,
+    size_t num_threads = 0
+  );
+
+  /**
+   * @brief Merges intersections which have the same point
+   *
+   * Sorts the intersections by point, then merges those with the same point
+   * (within `geometry::EPS`) into one, with the union of their segments sorted by id.
+   *
+   * @param intersections The list of intersections to merge in place
+   */
+  void merge_intersection_points(std::vector<intersection_t> &intersections);
+
+  /**
+   * @brief The coordinates a `basic_solver` sweeps in, so that its tolerance is relative to the extent of the input
+   *
+   * `geometry::tolerance<T>` is absolute, so the same input at another scale would be swept with another relative accuracy,
+   * too coarse for small inputs, e.g. a few hundred metres in degrees of longitude and latitude, and finer than rounding allows
+   * for large ones. Every input is hence scaled by a power of two to span between half of `basic_frame::span` and all of it,
+   * 1024 for `double` and 16 for `float`, whose tolerance is meant for coordinates up to that magnitude, and inputs which lie
+   * far from the origin compared to their extent are moved next to it by a multiple of a power of two no less than their extent.
+   * Neither rounds, so the end points, and every coincidence among them, are kept exactly, and an input scaled by a power
+   * of two is swept exactly as the input itself; intersections are mapped back as they are passed on, rounding once.
+   *
+   * Inputs which already span that much around the origin are swept as they are.
+   *
+   * @tparam T The scalar type of the coordinates, `float` or `double`
+   */
+  template <typename T>
+  struct basic_frame {
+    static constexpr int span_log2 = std::is_same<T, float>::value? 4 : 10;  ///< The log2 of the extent inputs are scaled to
+    static constexpr T span = T(1 << span_log2);                              ///< The extent inputs are scaled to
+
+    geometry::basic_point<T> origin { 0, 0 };   ///< The point of the input moved to the origin
+    T scale { 1 };                               ///< The power of two coordinates are scaled by, once moved
+
+    /**
+     * @brief Fits a frame to \a segments
+     *
+     * @param segments The segments
+     * @return `basic_frame` The frame, which leaves them as they are if they are empty or span a single point
+     */
+    static basic_frame fit(const std::vector<geometry::basic_segment<T>> &segments) {
+      basic_frame frame;
+      if(segments.empty())
+        return frame;
+
+      geometry::basic_point<T> lo = segments[0].p, hi = lo;
+      for(auto &seg: segments)
+        for(auto &pt: { seg.p, seg.q }) {
+          lo.x = std::min(lo.x, pt.x), lo.y = std::min(lo.y, pt.y);
+          hi.x = std::max(hi.x, pt.x), hi.y = std::max(hi.y, pt.y);
+        }
+
+      T extent = std::max(hi.x - lo.x, hi.y - lo.y);
+      if(!(extent > 0) or !std::isfinite(extent))
+        return frame;
+
+      // the least power of two greater than the extent, which is scaled to span
+      int k = std::ilogb(extent) + 1;
+      T unit = std::ldexp(T(1), k);
+      frame.scale = std::ldexp(T(1), span_log2 - k);
+
+      // every coordinate lies within unit / 2 of the middle, and the middle within unit / 2 of a multiple of unit,
+      // so a coordinate and the multiple it is moved by lie within a factor of 2 of one another if the middle lies
+      // 4 * unit or more away from the origin, and their difference is exact
+      auto snap = [unit](T lo, T hi) {
+        T mid = lo + (hi - lo) / 2;
+        return std::fabs(mid) < 4 * unit? T(0) : std::round(mid / unit) * unit;
+      };
+      frame.origin = { snap(lo.x, hi.x), snap(lo.y, hi.y) };
+      return frame;
+    }
+
+    /// @return `bool` `true` if coordinates are swept as they are
+    bool is_identity() const { return origin.x == 0 and origin.y == 0 and scale == 1; }
+
+    /// @return `T` The x coordinate \a x of the input in the frame, the limits of `T` standing for no bound are kept as they are
+    T local_x(T x) const { return std::fabs(x) == std::numeric_limits<T>::max()? x : (x - origin.x) * scale; }
+
+    /// @return `T` The y coordinate \a y of the input in the frame, the limits of `T` standing for no bound are kept as they are
+    T local_y(T y) const { return std::fabs(y) == std::numeric_limits<T>::max()? y : (y - origin.y) * scale; }
+
+    /// @return `T` The x coordinate of the input at \a x in the frame, the limits of `T` are kept as they are
+    T world_x(T x) const { return std::fabs(x) == std::numeric_limits<T>::max()? x : x / scale + origin.x; }
+
+    /// @return `T` The y coordinate of the input at \a y in the frame, the limits of `T` are kept as they are
+    T world_y(T y) const { return std::fabs(y) == std::numeric_limits<T>::max()? y : y / scale + origin.y; }
+
+    /// @return `geometry::basic_point<T>` The point \a pt of the input in the frame
+    geometry::basic_point<T> to_local(const geometry::basic_point<T> &pt) const { return { local_x(pt.x), local_y(pt.y) }; }
+
+    /// @return `geometry::basic_point<T>` The point of the input at \a pt in the frame
+    geometry::basic_point<T> to_world(const geometry::basic_point<T> &pt) const { return { world_x(pt.x), world_y(pt.y) }; }
+  };
+
+  /**
+   * @brief The input segments of a `basic_solver` laid out as a structure of arrays, which its segment ordering refers to by id
+   *
+   * Segment `i` is row `i`, so the segment ordering need only hold 32-bit ids, and a comparison reads the three values
+   * `x1[i]`, `y1[i]` and `slopes[i]` it needs rather than a whole segment. One more row past the segments is the probe,
+   * a single point which stands in for a search key, see `basic_segment_table::probe()`.
+   *
+   * @tparam T The scalar type of the coordinates, `float` or `double`
+   */
   template <typename T>
-  using bbst = BBST::red_black_tree<T>;   ///< Type alias for the underlying BBST used. Works with std::set in exactly the same way as well.
-  // using bbst = std::set<T>; // works with std::set in exactly the same way (don't forget to #include <set>)
+  struct basic_segment_table {
+    std::vector<T> x1 { 0 };        ///< The x coordinate of p of every segment
+    std::vector<T> y1 { 0 };        ///< The y coordinate of p of every segment
+    std::vector<T> x2 { 0 };        ///< The x coordinate of q of every segment
+    std::vector<T> y2 { 0 };        ///< The y coordinate of q of every segment
+    std::vector<T> slopes { -std::numeric_limits<T>::infinity() };  ///< The slope of every segment as `basic_segment::slope()` computes it, once
+
+    /**
+     * @brief Replaces the segments with \a segments, keeping the memory allocated
+     *
+     * @pre `segments[i].seg_id == i` must hold, since segments are only ever referred to by their row.
+     *
+     * @param segments The segments
+     * @param frame The frame to lay them out in
+     */
+    void assign(const std::vector<geometry::basic_segment<T>> &segments, const basic_frame<T> &frame = {}) {
+      for(auto *v: { &x1, &y1, &x2, &y2, &slopes })
+        v->resize(segments.size() + 1);
+
+      for(size_t i = 0; i < segments.size(); i++) {
+        x1[i] = frame.local_x(segments[i].p.x), y1[i] = frame.local_y(segments[i].p.y);
+        x2[i] = frame.local_x(segments[i].q.x), y2[i] = frame.local_y(segments[i].q.y);
+        slopes[i] = segment(i).slope();
+      }
+      slopes.back() = -std::numeric_limits<T>::infinity();
+    }
+
+    /// @return `size_t` The number of segments, the probe aside
+    size_t size() const { return x1.size() - 1; }
+
+    /**
+     * @brief Same as `geometry::basic_segment::eval_y()`, for segment \a id, using the slope computed up front
+     *
+     * @param id The segment
+     * @param x The x coordinate of the point to be found on the segment
+     * @return `y` The corresponding y coordinate of the desired point
+     */
+    T eval_y(size_t id, T x) const {
+      using W = geometry::compute_t<T>;
+      return slopes[id] == -std::numeric_limits<T>::infinity()? y1[id]
+                : T(y1[id] + W(slopes[id]) * (W(x) - x1[id]));
+    }
+
+    /**
+     * @brief Builds segment \a id
+     *
+     * @param id The segment
+     * @return `geometry::basic_segment<T>` The segment, with id \a id
+     */
+    geometry::basic_segment<T> segment(size_t id) const {
+      return { { x1[id], y1[id] }, { x2[id], y2[id] }, id };
+    }
+
+    /**
+     * @brief Moves the probe to a point, so it may be looked up in the segment ordering
+     *
+     * As a single point with slope `-inf`, the probe compares less than every segment passing through it.
+     *
+     * @param pt The point
+     * @return `std::uint32_t` The id of the probe
+     */
+    std::uint32_t probe(const geometry::basic_point<T> &pt) {
+      size_t id = size();
+      x1[id] = x2[id] = pt.x;
+      y1[id] = y2[id] = pt.y;
+      return std::uint32_t(id);
+    }
+  };
+
+  /**
+   * @brief Compare functor for the segment ordering BBST, which holds the ids of the segments
+   *
+   * Bound to the sweepline and the `basic_segment_table` of the `solver` which owns the BBST, so that
+   * no state is shared between solvers running on different threads.
+   *
+   * Compares y coordinates of segments by calling `basic_segment_table::eval_y()` with the current x coordinate of the sweepline,
+   * so no division is done on comparison. <br>
+   * All floating point comparisons are done within a neighbourhood of `geometry::tolerance<T>`.
+   *
+   * Segments which meet at the sweepline are ordered as they are just past it, i.e. by their slopes.
+   * A single point used as a search key hence compares less than every segment passing through it.
+   *
+   * @tparam T The scalar type of the coordinates, `float` or `double`
+   */
+  template <typename T>
+  struct basic_segment_comparator {
+    /// A pointer to the x coordinate of the sweepline this comparator is bound to
+    const T *sweeplineX { nullptr };
+
+    /// A pointer to the segments the ids refer to
+    const basic_segment_table<T> *segments { nullptr };
+
+#ifdef SWEEPLINE_STATS
+    /// The number of comparisons made so far, mutable since a tree only holds on to a const compare functor
+    mutable size_t num_calls { 0 };
+#endif
+
+    /**
+     * @brief Compares two segments at the current position of the sweepline
+     *
+     * @param a The id of the first segment
+     * @param b The id of the second segment
+     * @return `true` if the y coordinate of \a a corresponding to `*sweeplineX` is lesser than that of \a b,
+     * or if they are equal and \a a has a lesser slope
+     * @return `false` otherwise
+     */
+    bool operator () (std::uint32_t a, std::uint32_t b) const;
+  };
+
+  /// The compare functor for segments with `geometry::float_t` coordinates
+  using segment_comparator = basic_segment_comparator<geometry::float_t>;
 
   /**
    * @brief A utility class instantiated by `find_intersections()`
    * to manage the data structures and implement the algorithm
    * to find all intersection points.
    *
+   * All state, including the position of the sweepline, is owned by the instance,
+   * hence distinct solvers may run concurrently on different threads.
+   *
+   * @tparam T The scalar type of the coordinates, `float` or `double`; every comparison is made
+   * within `geometry::tolerance<T>`
+   * @tparam EventQueue The priority queue of events, one of those in `event_queue.hpp`
    */
-  class solver {
+  template <typename T, typename EventQueue = default_event_queue<basic_event<T>>>
+  class basic_solver {
+    using point = geometry::basic_point<T>;
+    using segment = geometry::basic_segment<T>;
+    using event = basic_event<T>;
+    using intersection = basic_intersection<T>;
+    using status_iterator = typename bbst<std::uint32_t, basic_segment_comparator<T>>::iterator;
+    using status_node = typename bbst<std::uint32_t, basic_segment_comparator<T>>::node_type;
+
+    /// The tolerance every comparison is made within
+    static constexpr T eps = geometry::tolerance<T>;
+
     bool verbose;                                     ///< The `utils::args::verbose` flag
-    std::vector<geometry::segment_t> line_segments;   ///< The list of input line segments
-    std::vector<sweepline::intersection_t> result;    ///< The list of intersections that will be returned
+    basic_frame<T> frame;                             ///< The coordinates the sweep is done in, fitted to the input
+    basic_segment_table<T> line_segments;             ///< The list of input line segments as a structure of arrays in `basic_solver::frame`, with their slopes computed once
+
+    /// An intersection found during the sweep, whose segments are the ids in `[first, last)` of a separate list
+    struct found_t {
+      point pt;               ///< The point of intersection
+      size_t first;           ///< The index of the first segment id
+      size_t last;            ///< The index past the last segment id
+    };
+
+    const basic_intersection_sink<T> *sink { nullptr };   ///< The sink receiving intersections during `basic_solver::solve()`, none while counting
+    basic_intersection_list<T> *list { nullptr };     ///< The list receiving intersections during `basic_solver::solve()` instead of a sink, if set
+    intersection_count counts { 0, 0 };               ///< The intersections counted so far by `basic_solver::count()`
+    bool stop_at_first { false };                     ///< Set by `basic_solver::any_intersection()` to stop at the first intersection
+    std::optional<intersection> witness;              ///< The first intersection found when `basic_solver::stop_at_first` is set
+    std::vector<found_t> pending;                     ///< Intersections close to the sweepline, which may still be merged with ones yet to be found
+    std::vector<size_t> pending_ids;                  ///< The segments of the pending intersections
+    T pending_min_x { std::numeric_limits<T>::infinity() };  ///< The least x coordinate among the pending intersections
+    std::vector<found_t> vertical_intersections;      ///< Intersections between vertical segments, sorted by point
+    std::vector<size_t> vertical_ids;                 ///< The segments of the intersections between vertical segments
+    std::optional<basic_query_window<T>> window;      ///< If set, only intersections in the window, in the coordinates of the frame, are passed on
+    size_t num_red { 0 };                             ///< Segments with lesser ids are red and the rest blue, only intersections of both colours are passed on if non-zero
+
+    T sweeplineX;                                     ///< The current x coordinate of the vertical sweepline
+
+    std::vector<endpoint_event> endpoints;            ///< The begin and end events, sorted once before the sweep
+    size_t next_endpoint { 0 };                       ///< The index in `basic_solver::endpoints` of the next event
+    event endpoint_head;                              ///< The event at `basic_solver::next_endpoint`, with its point
+    EventQueue event_queue;                           ///< The event queue of the intersection events found during the sweep
+    bbst<std::uint32_t, basic_segment_comparator<T>> seg_ordering { basic_segment_comparator<T>{ &sweeplineX, &line_segments } };  ///< The status queue, or segment ordering, implemented as a BBST of segment ids
+    std::vector<status_iterator> handles;             ///< The node of each segment in `basic_solver::seg_ordering`, or its end if it is not there
+
+    /// The last two pairs checked for a segment with each of its neighbours in `basic_solver::seg_ordering`, and where their events lie
+    struct scheduled_pairs {
+      static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
 
-    bbst<sweepline::event_t> event_queue;             ///< The event queue, implemented as a BBST of events
-    bbst<geometry::segment_t> seg_ordering;           ///< The status queue, or segment ordering, implemented as a BBST of segments
-    std::vector<geometry::segment_t> vertical_segs;   ///< A list of line segments with slope parallel to the sweepline (vertical) that will be handled separately
+      std::uint32_t above { none };        ///< The segment just above when last checked, or none
+      std::uint32_t below { none };        ///< The segment just below when last checked, or none
+      std::uint32_t prev_above { none };   ///< The segment just above before that, or none
+      std::uint32_t prev_below { none };   ///< The segment just below before that, or none
+
+      /// The points of the events scheduled with each of them, NaN if none was
+      point above_pt { std::numeric_limits<T>::quiet_NaN(), std::numeric_limits<T>::quiet_NaN() },
+            below_pt { above_pt }, prev_above_pt { above_pt }, prev_below_pt { above_pt };
+    };
+
+    std::vector<scheduled_pairs> scheduled;           ///< The pairs last checked for every segment
+    size_t compact_at { 0 };                          ///< The size of the event queue at which its stale events are removed
+    std::vector<event> live_events;                   ///< The events kept by `basic_solver::compact_event_queue`, reused across compactions
+    event_count saved;                                ///< The number of events saved by the last sweep
+    std::vector<segment> vertical_segs;               ///< A list of line segments with slope parallel to the sweepline (vertical) that will be handled separately
 
   public:
 
@@ -82,7 +724,54 @@ namespace sweepline {
      * @param verbose The `utils::args::verbose` flag
      * @param enable_color The `utils::args::enable_color` flag
      */
-    solver(const std::vector<geometry::segment_t> &line_segments, bool verbose, bool enable_color);
+    basic_solver(const std::vector<geometry::basic_segment<T>> &line_segments, bool verbose, bool enable_color);
+
+    /**
+     * @brief Constructor for a solver restricted to the vertical slab \f$ [slab\_begin, slab\_end) \f$
+     *
+     * Used by `find_intersections_parallel()`. Non-vertical segments which start before the slab
+     * are clipped to begin where they cross \f$ x = slab\_begin \f$, and segments which end after it are never removed.
+     * Intersections within `geometry::EPS` of a boundary are left to the slab before it, so only intersections within
+     * the slab (give or take `geometry::EPS`) are found.
+     *
+     * @pre `line_segments[i].seg_id == i` must hold, since events refer to segments by their index.
+     *
+     * @param line_segments The list of input line segments
+     * @param slab_begin The x coordinate where the slab begins
+     * @param slab_end The x coordinate where the slab ends
+     * @param num_red If non-zero, segments with lesser ids are red and the rest blue, and only intersections which involve
+     * both colours are passed on, as in `find_red_blue_intersections()`
+     * @param frame The frame to sweep in, fitted to \a line_segments if not given. The slabs of one input are swept
+     * in the frame fitted to all of it, so that every slab compares within the same tolerance as a single sweep would
+     */
+    basic_solver(
+      const std::vector<geometry::basic_segment<T>> &line_segments,
+      T slab_begin,
+      T slab_end,
+      size_t num_red = 0,
+      const std::optional<basic_frame<T>> &frame = std::nullopt
+    );
+
+    /**
+     * @brief Constructor for a solver restricted to an axis aligned window
+     *
+     * Used by `find_intersections()` with a `query_window`. Segments are clipped to the window, just enlarged so that
+     * no clipped end point lies on it, and only intersections in the window are passed on. The cuts lie a fixed
+     * margin out from the window wherever it is, and finding them scans the whole input in \f$ O(n) \f$. The segments
+     * keep their original geometry, so the intersections found are exactly those of the unclipped segments.
+     *
+     * @pre `line_segments[i].seg_id == i` must hold, since events refer to segments by their index.
+     *
+     * @param line_segments The list of input line segments
+     * @param window The window to look for intersections in
+     */
+    basic_solver(const std::vector<geometry::basic_segment<T>> &line_segments, const basic_query_window<T> &window);
+
+    /// \cond
+    // seg_ordering holds a pointer to sweeplineX, so a copy would compare against the wrong sweepline
+    basic_solver(const basic_solver &) = delete;
+    basic_solver &operator = (const basic_solver &) = delete;
+    /// \endcond
 
     /**
      * @brief Finds which segments intersect at which points and returns all such intersections
@@ -100,22 +789,133 @@ namespace sweepline {
      *
      * @return `std::vector<intersection_t>` A list of all intersections
      */
-    std::vector<sweepline::intersection_t> solve();
+    std::vector<basic_intersection<T>> solve();
+
+    /**
+     * @brief Finds all intersections like `basic_solver::solve()`, handing each one to \a sink as soon as it is final
+     *
+     * Intersections are passed on in the same order and with the same segments as `basic_solver::solve()` returns them.
+     * Only intersections close to the sweepline are held back, to be merged with others at the same point.
+     *
+     * @param sink The callback receiving each intersection
+     */
+    void solve(const basic_intersection_sink<T> &sink);
+
+    /**
+     * @brief Finds all intersections like `basic_solver::solve()`, appending each one to \a result as soon as it is final
+     *
+     * @param result The list to append the intersections to, cleared first
+     */
+    void solve(basic_intersection_list<T> &result);
+
+    /**
+     * @brief Counts the intersections `basic_solver::solve()` would find, without building them
+     *
+     * @return `intersection_count` The number of intersection points and of intersecting pairs of segments
+     */
+    intersection_count count();
+
+    /**
+     * @brief Checks whether any two segments intersect, stopping at the first intersection found
+     *
+     * @return `std::optional<intersection_t>` The point and the ids (in increasing order) of two segments which intersect there, if any
+     */
+    std::optional<basic_intersection<T>> any_intersection();
+
+    /**
+     * @brief Prepares the solver for another list of line segments, keeping the memory it has already allocated
+     *
+     * Meant for solving many small instances one after another, as in `find_intersections_batch()`.
+     * The slab and the colours the solver was constructed with are kept as they are.
+     *
+     * @pre `line_segments[i].seg_id == i` must hold, since events refer to segments by their index.
+     *
+     * @param line_segments The new list of input line segments
+     */
+    void reset(const std::vector<geometry::basic_segment<T>> &line_segments);
+
+#ifdef SWEEPLINE_STATS
+    /**
+     * @brief Gets the number of comparisons `basic_solver::seg_ordering` has made, for tests and benchmarks
+     * @note Only counted when built with `SWEEPLINE_STATS`, so that the comparator does nothing else otherwise.
+     *
+     * @return `size_t` The number of comparisons between segments in the status queue since the solver was constructed
+     */
+    size_t num_comparisons() const { return seg_ordering.key_comp().num_calls; }
+#endif
+
+    /**
+     * @brief Gets the number of intersection events the last sweep saved
+     *
+     * @return `const event_count&` The counts
+     */
+    const event_count &event_counts() const { return saved; }
+
+    /**
+     * @brief Checks that walking `basic_solver::seg_ordering` from its first node reaches every segment with a handle,
+     * through that handle, for tests
+     *
+     * May be called from a sink during the sweep.
+     *
+     * @return `true` if the handles and the segment ordering agree
+     * @return `false` otherwise
+     */
+    bool handles_are_valid() const;
+
+    /**
+     * @brief Gets the x coordinate of the sweepline, in the coordinates of the input, for tests
+     *
+     * May be called from a sink during the sweep.
+     *
+     * @return `T` The x coordinate of the last event processed
+     */
+    T sweepline_x() const { return frame.world_x(sweeplineX); }
 
   private:
   // Implementation
 
     /**
-     * @brief Initializes the `solver::event_queue` by inserting the end points of the `solver::line_segments` and populates `solver::vertical_segs` with vertical segments
+     * @brief Runs the sweep, passing every intersection on to `basic_solver::sink`, or counting it if there is none
+     *
+     */
+    void sweep();
+
+    /**
+     * @brief Initializes `basic_solver::endpoints` with the end points of the `basic_solver::line_segments` and populates `basic_solver::vertical_segs` with vertical segments
      * @pre \f$ p \le q \f$ must hold for each line segment in the list.
      *
-     * Iterates over the segments in `solver::line_segments`
-     * 1. Vertical segments are added to `solver::vertical_segs`
-     * 2. For all other segments, the begin and end points are inserted into the `solver::event_queue` as begin and end events respectively
+     * Iterates over the segments in `basic_solver::line_segments`
+     * 1. Vertical segments are added to `basic_solver::vertical_segs`
+     * 2. For all other segments, the begin and end points are added to `basic_solver::endpoints` as begin and end events respectively
+     *
+     * Begin points before the slab are clipped to the slab, and end points after it are left out.
+     * The end points are then sorted once, by `radix_sort()` on their x coordinates and by y among those with the same x,
+     * so that only the intersection events found during the sweep go through `basic_solver::event_queue`.
      *
+     * @throws std::length_error if there are \f$ 2^{32} \f$ or more line segments, whose ids do not fit in an `endpoint_event`
      */
     void init_event_queue();
 
+    /**
+     * @brief Gets the event an `endpoint_event` stands for
+     *
+     * @param e The endpoint event
+     * @return `event` The event at the point of its segment at its x coordinate
+     */
+    event endpoint(const endpoint_event &e) const;
+
+    /// @return `true` if any events are left, either end points or intersections
+    bool has_events() const;
+
+    /// @return `const event &` The next event, the lesser of `basic_solver::endpoint_head` and the top of `basic_solver::event_queue`
+    const event &top_event() const;
+
+    /// @brief Removes the next event
+    void pop_event();
+
+    /// @return `std::vector<event>` The events left, the end points in order followed by the intersections, for debugging
+    std::vector<event> remaining_events() const;
+
     /**
      * @brief Finds intersections between pairs of vertical line segments
      *
@@ -129,51 +929,96 @@ namespace sweepline {
      * @brief Finds intersections between a vertical line segment and one or more non-vertical segments
      *
      * Iterates over vertical line segments (ordered by x) whose `x` coordinate lies before the new sweepline.
-     * Non-vertical segments which intersect with a particular vertical segment are found by querying `solver::seg_ordering`.
+     * Non-vertical segments which intersect with a particular vertical segment are found by querying `basic_solver::seg_ordering`.
      *
      * @param max_vsegx The `x` coordinate of the next event, i.e. the new sweepline.
      */
-    void find_vertical_nonvertical_intersections(geometry::float_t max_vsegx);
+    void find_vertical_nonvertical_intersections(T max_vsegx);
 
     /**
      * @brief Gets the active segments with an event at the point currently being processed
      *
      * @param top One of the events at the point currently being processed
-     * @return `std::array<std::vector<size_t>, 3>` Three arrays of active segment indices corresponding to `event_t::type`
+     * @return `std::array<std::vector<size_t>, 3>` Three arrays of active segment indices corresponding to `event_t::type`,
+     * reused by the next call
      */
-    std::array<std::vector<size_t>, 3> get_active_segs(sweepline::event_t top);
+    std::array<std::vector<size_t>, 3> &get_active_segs(event top);
 
     /**
-     * @brief Updates the status queue `solver::seg_ordering` after processing the event point
+     * @brief Updates the status queue `basic_solver::seg_ordering` after processing the event point
      *
-     * * Removes all segments with `event_t::type::end` and `event_t::type::interior` events
-     * * Increments the sweepline by a very small amount, just past the intersection point
-     * * Inserts all segments with `event_t::type::begin` events and reinserts the removed
-     * segments with `event_t::type::interior` events in the correct order
+     * * Segments already in `basic_solver::seg_ordering` which pass through \a cur without an event there
+     * are added to \a active_segs as `event_t::type::interior`
+     * * Removes all segments with `event_t::type::end` events through `basic_solver::handles`,
+     * without searching `basic_solver::seg_ordering` by key
+     * * Segments with `event_t::type::interior` events cross at \a cur, so they form a contiguous run
+     * which is ordered by decreasing slope just before \a cur and by increasing slope just past it, as
+     * `segment_comparator` breaks ties by slope. The run is reversed in place, and only where it is not
+     * such a run (e.g. a segment strayed from \a cur) are they removed and reinserted instead
+     * * Inserts all segments with `event_t::type::begin` events
      *
+     * @param cur The point currently being processed
      * @param active_segs The active segments with an event at the point currently being processed
      */
-    void update_segment_ordering(const std::array<std::vector<size_t>, 3> &active_segs);
+    void update_segment_ordering(point cur, std::array<std::vector<size_t>, 3> &active_segs);
+
+    /**
+     * @brief Schedules the intersection of two adjacent segments as an event if it lies past \a cur
+     *
+     * Intersections at or before \a cur have already been found by `basic_solver::update_segment_ordering`.
+     * A pair which is still the last one checked for both segments is not checked again, nor is one which was
+     * the one checked before that for both, whose events become live again unless the queue was compacted since.
+     * The events of the pairs either segment was last checked with become stale, see `basic_solver::is_stale`.
+     * A segment gets no second event at a point its other neighbour already scheduled it at, so a point where
+     * \f$ d \f$ segments meet is popped as \f$ d \f$ events.
+     *
+     * @param below The id of the lower of the two adjacent segments
+     * @param above The id of the upper of the two adjacent segments
+     * @param cur The point currently being processed
+     */
+    void find_new_event(std::uint32_t below, std::uint32_t above, point cur);
 
     /**
-     * @brief Tests for new event points after updating `solver::seg_ordering` in the case when no new segments are inserted
+     * @brief Checks whether an intersection event belongs to a pair of segments which is no longer adjacent
+     *
+     * Every segment keeps at most one live event with each of its two neighbours, those of the pairs last
+     * checked by `basic_solver::find_new_event`, so the queue holds \f$ \mathcal{O}(n) \f$ live events.
+     *
+     * @param e The event
+     * @return `true` if \a e is an interior event at neither of the points scheduled for its segment
+     * @return `false` otherwise
+     */
+    bool is_stale(const event &e) const;
+
+    /**
+     * @brief Removes the stale events, and the copies of live ones, from the event queue
+     *
+     * Called once the queue outgrows `basic_solver::compact_at`, which then doubles past the events kept,
+     * so the queue stays within a constant factor of its live events in amortized linear time.
+     * The previous pairs of every segment are forgotten, since their events are gone.
+     */
+    void compact_event_queue();
+
+    /**
+     * @brief Tests for new event points after updating `basic_solver::seg_ordering` in the case when no new segments are inserted
      *
      * If no segments were newly inserted, the immediate left and right neighbours
      * of the deleted set of segments become adjacent candidates for intersection.
      *
      * @param cur The current point being processed
      */
-    void handle_no_newly_inserted(geometry::point_t cur);
+    void handle_no_newly_inserted(point cur);
 
     /**
-     * @brief Tests for new event points after updating `solver::seg_ordering` in the case when some new segments are inserted
+     * @brief Tests for new event points after updating `basic_solver::seg_ordering` in the case when some new segments are inserted
      *
      * If some segments were newly inserted,
      * the left and right extremes among the set of newly inserted segments
      * must be checked for intersection with their immediate left and right neighbours respectively.
      *
+     * @param cur The current point being processed
      */
-    void handle_extremes_of_newly_inserted();
+    void handle_extremes_of_newly_inserted(point cur);
 
     /**
      * @brief Reports an intersection between teo or more (non-vertical) line segments
@@ -181,18 +1026,94 @@ namespace sweepline {
      * @param cur The point of intersection
      * @param active_segs The line segments that intersect at \a cur
      */
-    void report_intersection(geometry::point_t cur, std::array<std::vector<size_t>, 3> &&active_segs);
+    void report_intersection(point cur, const std::array<std::vector<size_t>, 3> &active_segs);
 
     /**
-     * @brief Merge intersections which have the same point
+     * @brief Merges pending intersections before \a before and passes them on to `basic_solver::list` or `basic_solver::sink`, or counts them
+     *
+     * Every intersection found from here on lies at or past `before + basic_solver::eps`,
+     * so the pending ones before \a before are final. They are merged with the same rules as
+     * `merge_intersection_points()` and handed over in order.
      *
+     * @param before The x coordinate before which pending intersections are passed on
      */
-    void merge_intersection_points();
+    void flush_intersections(T before);
+
+    /**
+     * @brief Notes that segments \a a and \a b intersect at \a pt, the first such pair becomes `basic_solver::witness`
+     *
+     * @param pt The point of intersection
+     * @param a The id of one segment
+     * @param b The id of the other segment
+     */
+    void detected(point pt, size_t a, size_t b);
+
+    /**
+     * @brief Adds an intersection at \a pt to the pending ones
+     *
+     * @param pt The point of intersection
+     * @param first The index in `basic_solver::pending_ids` of its first segment, the rest follow up to the end
+     */
+    void add_pending(point pt, size_t first);
 
     /// \cond
+    T slab_begin = -std::numeric_limits<T>::max();
+    T slab_end = std::numeric_limits<T>::max();
+    T clip_lo_y = -std::numeric_limits<T>::max();   // segments are clipped to
+    T clip_hi_y = std::numeric_limits<T>::max();    // [clip_lo_y, clip_hi_y] too
     size_t vert_idx = 0;
-    geometry::float_t max_y, min_y;
+    size_t vert_vert_idx = 0;
+    std::array<std::vector<size_t>, 3> active;
+    std::vector<size_t> merged_ids, reinserted_ids;
+    std::vector<bool> removed_found;
+    std::vector<status_iterator> crossing;   // the run of segments crossing at the current point
+    std::vector<status_node> extracted;      // the nodes taken out of the status to be put back past the current point
+    size_t leftmost, rightmost;   // extremes among the newly inserted segments
     /// \endcond
   };
 
+  /// The solver for segments with `geometry::float_t` coordinates
+  using solver = basic_solver<geometry::float_t>;
+
+  /// \cond
+  extern template struct basic_segment_comparator<float>;
+  extern template struct basic_segment_comparator<double>;
+  extern template class basic_solver<float>;
+  extern template class basic_solver<double>;
+  extern template class basic_solver<double, bbst_event_queue<basic_event<double>>>;
+  extern template class basic_solver<double, heap_event_queue<basic_event<double>, 2>>;
+  extern template class basic_solver<double, radix_event_queue<basic_event<double>>>;
+  /// \endcond
+
+  /**
+   * @brief Finds all intersections like `find_intersections()`, handing each one to \a sink as soon as it is found
+   * @pre \f$ p \le q \f$ must hold for each line segment in the list.
+   * @pre No two line segments should coincide with each other either fully or partially.
+   *
+   * Nothing is buffered beyond the intersections close to the sweepline, so memory scales with the
+   * number of segments rather than the number of intersections.
+   *
+   * @code
+   * size_t num_points = 0;
+   * sweepline::find_intersections(segments, [&](sweepline::intersection_t &&it) { num_points++; });
+   * @endcode
+   *
+   * @tparam T The scalar type of the coordinates, `float` or `double`
+   * @tparam Sink Any callable accepting a `basic_intersection<T> &&`
+   * @param line_segments The list of input line segments
+   * @param sink The callback receiving each intersection, with all its segments merged, in the order `find_intersections()` returns them
+   * @param verbose The `utils::args::verbose` flag
+   * @param enable_color The `utils::args::enable_color` flag
+   */
+  template <typename T, typename Sink, typename = std::enable_if_t<std::is_invocable_v<Sink &, basic_intersection<T> &&>>>
+  void find_intersections(
+    const std::vector<geometry::basic_segment<T>> &line_segments,
+    Sink &&sink,
+    bool verbose = false,
+    bool enable_color = true
+  ) {
+
+    basic_solver<T>(line_segments, verbose, enable_color).solve(basic_intersection_sink<T>(std::ref(sink)));
+  }
+
 } // namespace sweepline
@@ -0,0 +1,119 @@
+/**
+ * @file thread_pool.hpp
+ * @author the-hyp0cr1t3
+ * @brief Describes a simple fixed size thread pool
+ * @date 2026-10-17
+ */
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace sweepline {
+
+  /**
+   * @brief A fixed size pool of worker threads which run batches of independent tasks
+   *
+   * Every batch is split into contiguous ranges of tasks, one per worker. A worker which runs out of tasks
+   * steals the back half of the range of another worker, so uneven tasks still keep every worker busy
+   * while workers seldom contend for the same lock.
+   *
+   * @code
+   * sweepline::thread_pool pool(4);
+   * std::vector<int> squares(100);
+   * pool.run(squares.size(), [&](size_t i) { squares[i] = i * i; });
+   * @endcode
+   */
+  class thread_pool {
+    /// The tasks `[begin, end)` left to a worker, guarded by its own lock
+    struct task_range {
+      std::mutex mtx;         ///< Guards the range
+      size_t begin { 0 };     ///< The index of the next task to be picked up
+      size_t end { 0 };       ///< The index past the last task
+    };
+
+    std::vector<std::thread> workers;                   ///< The worker threads
+    std::vector<std::unique_ptr<task_range>> ranges;    ///< The tasks left to each worker
+
+    std::mutex mtx;                     ///< Guards all the members below
+    std::condition_variable work_cv;    ///< Notified when a new batch is submitted or the pool is stopping
+    std::condition_variable done_cv;    ///< Notified when the last busy worker runs out of tasks
+
+    const std::function<void(size_t, size_t)> *task { nullptr };   ///< The task of the current batch
+    size_t batch { 0 };                 ///< The number of batches submitted so far
+    size_t num_busy { 0 };              ///< The number of workers which have not yet run out of tasks of the current batch
+    std::exception_ptr error;           ///< The first exception thrown by a task of the current batch
+    bool stopping { false };            ///< Set when the pool is being destroyed
+
+    /**
+     * @brief The loop run by every worker, runs the tasks of every batch until the pool is stopped
+     *
+     * @param worker The index of the worker
+     */
+    void worker_loop(size_t worker);
+
+    /**
+     * @brief Picks up the next task of a worker, stealing from the other workers once its own range is empty
+     *
+     * @param worker The index of the worker
+     * @param idx Set to the index of the task picked up
+     * @return `true` if a task was picked up
+     * @return `false` if no tasks are left anywhere
+     */
+    bool next_task(size_t worker, size_t &idx);
+
+  public:
+
+    /**
+     * @brief Constructor, starts the worker threads
+     *
+     * @param num_threads The number of worker threads, `0` picks `std::thread::hardware_concurrency()`
+     */
+    explicit thread_pool(size_t num_threads = 0);
+
+    /**
+     * @brief Destructor, waits for the workers to stop
+     */
+    ~thread_pool();
+
+    /// \cond
+    thread_pool(const thread_pool &) = delete;
+    thread_pool &operator = (const thread_pool &) = delete;
+    /// \endcond
+
+    /**
+     * @brief Gets the number of worker threads
+     *
+     * @return `size_t` The number of worker threads
+     */
+    size_t size() const { return workers.size(); }
+
+    /**
+     * @brief Runs `task(i)` for every \f$ i \in [0, num\_tasks) \f$ on the workers and waits for all of them to finish
+     *
+     * If any task throws, the first exception is rethrown once the batch is over.
+     *
+     * @param num_tasks The number of tasks
+     * @param task The task to run, called with the index of the task
+     */
+    void run(size_t num_tasks, const std::function<void(size_t)> &task);
+
+    /**
+     * @brief Runs `task(i, worker)` for every \f$ i \in [0, num\_tasks) \f$ on the workers and waits for all of them to finish
+     *
+     * Same as the above, except the task is also told which worker runs it,
+     * so that state may be kept per worker (i.e. indexed by \f$ worker \in [0, size()) \f$) and reused from one task to the next.
+     *
+     * @param num_tasks The number of tasks
+     * @param task The task to run, called with the index of the task and the index of the worker
+     */
+    void run(size_t num_tasks, const std::function<void(size_t, size_t)> &task);
+  };
+
+} // namespace sweepline
@@ -1,6 +1,10 @@
 #include <point.hpp>
 #include <cmath>
 
-bool geometry::point_t::operator == (const point_t &other) const {
-    return std::fabs(x - other.x) < EPS and std::fabs(y - other.y) < EPS;
-}
\ No newline at end of file
+template <typename T>
+bool geometry::basic_point<T>::operator == (const basic_point &other) const {
+    return std::fabs(x - other.x) < tolerance<T> and std::fabs(y - other.y) < tolerance<T>;
+}
+
+template struct geometry::basic_point<float>;
+template struct geometry::basic_point<double>;
\ No newline at end of file
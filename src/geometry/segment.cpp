@@ -1,50 +1,73 @@
 #include <segment.hpp>
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
-namespace sweepline {
-    /// A global variable which stores the current X coordinate of the vertical sweepline
-    extern geometry::float_t sweeplineX;
+template <typename T>
+T geometry::basic_segment<T>::eval_y(T x) const {
+    using W = compute_t<T>;
+    return std::fabs(p.x - q.x) < tolerance<T>? p.y
+                : T(p.y + (W(q.y) - p.y) * (W(x) - p.x) / (W(q.x) - p.x));
 }
 
-geometry::float_t geometry::segment_t::eval_y(geometry::float_t x) const {
-    return std::fabs(p.x - q.x) < EPS? p.y
-                : p.y + (q.y - p.y) * (x - p.x) / (q.x - p.x);
+template <typename T>
+T geometry::basic_segment<T>::slope() const {
+    using W = compute_t<T>;
+    return std::fabs(p.x - q.x) < tolerance<T>? -std::numeric_limits<T>::infinity()
+                : T((W(q.y) - p.y) / (W(q.x) - p.x));
 }
 
-bool geometry::segment_t::operator < (const segment_t &other) const {
-    return eval_y(sweepline::sweeplineX) < other.eval_y(sweepline::sweeplineX) - EPS;
-}
-
-bool geometry::can_intersect_1d(
-    geometry::float_t l1, geometry::float_t r1, geometry::float_t l2, geometry::float_t r2
-) {
+template <typename T>
+bool geometry::can_intersect_1d(T l1, T r1, T l2, T r2) {
     if(l1 > r1) std::swap(l1, r1);
     if(l2 > r2) std::swap(l2, r2);
-    return std::max(l1, l2) <= std::min(r1, r2) + EPS;
+    return std::max(l1, l2) <= std::min(r1, r2) + tolerance<T>;
 }
 
+template <typename T>
 int geometry::cross_prod(
-    const geometry::point_t &a, const geometry::point_t &b, const geometry::point_t &c
+    const geometry::basic_point<T> &a, const geometry::basic_point<T> &b, const geometry::basic_point<T> &c
 ) {
-    geometry::float_t s = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
-    return std::fabs(s) < EPS ? 0 : s > 0 ? +1 : -1;
+    using W = compute_t<T>;
+    W ux = W(b.x) - a.x, uy = W(b.y) - a.y, vx = W(c.x) - a.x, vy = W(c.y) - a.y;
+    W s = ux * vy - uy * vx;
+    // |s| over the longer of ab and ac is (within a factor of 2) the distance of the other point from the line
+    // through it, which is what the tolerance bounds, regardless of how large or small the segments are
+    W len = std::max(std::max(std::fabs(ux), std::fabs(uy)), std::max(std::fabs(vx), std::fabs(vy)));
+    return std::fabs(s) < tolerance<T> * len ? 0 : s > 0 ? +1 : -1;
 }
 
-bool geometry::is_intersecting(const segment_t &a, const segment_t &b) {
+template <typename T>
+bool geometry::is_intersecting(const basic_segment<T> &a, const basic_segment<T> &b) {
     return can_intersect_1d(a.p.x, a.q.x, b.p.x, b.q.x)
            and can_intersect_1d(a.p.y, a.q.y, b.p.y, b.q.y)
            and cross_prod(a.p, a.q, b.p) * cross_prod(a.p, a.q, b.q) <= 0
            and cross_prod(b.p, b.q, a.p) * cross_prod(b.p, b.q, a.q) <= 0;
 }
 
-geometry::point_t geometry::intersection_point(const segment_t &a, const segment_t &b) {
-    geometry::float_t A1 = a.p.y - a.q.y;
-    geometry::float_t B1 = a.q.x - a.p.x;
-    geometry::float_t C1 = (a.p.y - a.q.y) * (-a.p.x) + (a.q.x - a.p.x) * (-a.p.y);
+template <typename T>
+geometry::basic_point<T> geometry::intersection_point(const basic_segment<T> &a, const basic_segment<T> &b) {
+    using W = compute_t<T>;
+    W A1 = W(a.p.y) - a.q.y;
+    W B1 = W(a.q.x) - a.p.x;
+    W C1 = A1 * (-a.p.x) + B1 * (-a.p.y);
+
+    W A2 = W(b.p.y) - b.q.y;
+    W B2 = W(b.q.x) - b.p.x;
+    W C2 = A2 * (-b.p.x) + B2 * (-b.p.y);
+
+    return geometry::basic_point<T> {T((B1 * C2 - B2 * C1) / (A1 * B2 - A2 * B1)), T((C1 * A2 - C2 * A1) / (A1 * B2 - A2 * B1))};
+}
 
-    geometry::float_t A2 = b.p.y - b.q.y;
-    geometry::float_t B2 = b.q.x - b.p.x;
-    geometry::float_t C2 = (b.p.y - b.q.y) * (-b.p.x) + (b.q.x - b.p.x) * (-b.p.y);
+/// \cond
+#define GEOMETRY_INSTANTIATE_SEGMENT(T) \
+    template struct geometry::basic_segment<T>; \
+    template bool geometry::can_intersect_1d(T, T, T, T); \
+    template int geometry::cross_prod(const basic_point<T> &, const basic_point<T> &, const basic_point<T> &); \
+    template bool geometry::is_intersecting(const basic_segment<T> &, const basic_segment<T> &); \
+    template geometry::basic_point<T> geometry::intersection_point(const basic_segment<T> &, const basic_segment<T> &);
 
-    return geometry::point_t {(B1 * C2 - B2 * C1) / (A1 * B2 - A2 * B1), (C1 * A2 - C2 * A1) / (A1 * B2 - A2 * B1)};
-}
\ No newline at end of file
+GEOMETRY_INSTANTIATE_SEGMENT(float)
+GEOMETRY_INSTANTIATE_SEGMENT(double)
+#undef GEOMETRY_INSTANTIATE_SEGMENT
+/// \endcond
\ No newline at end of file
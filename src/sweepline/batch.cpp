@@ -0,0 +1,39 @@
+#include <sweepline.hpp>
+#include <thread_pool.hpp>
+
+#include <memory>
+#include <vector>
+
+std::vector<std::vector<sweepline::intersection_t>> sweepline::find_intersections_batch(
+  const std::vector<std::vector<geometry::segment_t>> &instances,
+  sweepline::thread_pool &pool
+) {
+
+  std::vector<std::vector<sweepline::intersection_t>> results(instances.size());
+
+  // one solver per worker, created by its first instance and reset for every one after that
+  std::vector<std::unique_ptr<sweepline::solver>> solvers(pool.size());
+
+  pool.run(instances.size(), [&](size_t i, size_t worker) {
+    auto &cur_solver = solvers[worker];
+    if(!cur_solver)
+      cur_solver = std::make_unique<sweepline::solver>(instances[i], false, false);
+    else
+      cur_solver->reset(instances[i]);
+
+    cur_solver->solve([&result = results[i]](sweepline::intersection_t &&it) {
+      result.emplace_back(std::move(it));
+    });
+  });
+
+  return results;
+}
+
+std::vector<std::vector<sweepline::intersection_t>> sweepline::find_intersections_batch(
+  const std::vector<std::vector<geometry::segment_t>> &instances,
+  size_t num_threads
+) {
+
+  sweepline::thread_pool pool(num_threads);
+  return sweepline::find_intersections_batch(instances, pool);
+}
@@ -0,0 +1,179 @@
+#include <dynamic_index.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+// This namespace is meant to be hidden from the API
+// provides the grid cell arithmetic of the dynamic index
+namespace detail {
+
+  /// The index of the cell holding coordinate x, clamped to 32 bits
+  std::int64_t cell_of(geometry::float_t x, geometry::float_t cell_size) {
+    geometry::float_t i = std::floor(x / cell_size);
+    return std::clamp<geometry::float_t>(i,
+      std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max());
+  }
+
+  /// Packs the cell at column i and row j into a single key
+  std::uint64_t cell_key(std::int64_t i, std::int64_t j) {
+    return static_cast<std::uint64_t>(static_cast<std::uint32_t>(i)) << 32 | static_cast<std::uint32_t>(j);
+  }
+
+} // namespace detail
+
+sweepline::dynamic_index::dynamic_index(geometry::float_t cell_size) : cell_size(cell_size) {
+  if(!(cell_size > 0) or !std::isfinite(cell_size))
+    throw std::invalid_argument("The cell size of a dynamic_index must be positive and finite");
+}
+
+sweepline::dynamic_index::dynamic_index(const std::vector<geometry::segment_t> &line_segments) {
+  geometry::float_t extent = 0;
+  for(auto &seg: line_segments)
+    extent += std::max(seg.q.x - seg.p.x, std::fabs(seg.q.y - seg.p.y));
+  cell_size = line_segments.empty() or extent < geometry::EPS? 1 : extent / line_segments.size();
+  if(!std::isfinite(cell_size))
+    cell_size = 1;
+
+  // the sweep needs ids to match positions
+  std::vector<geometry::segment_t> renumbered(line_segments);
+  for(size_t i = 0; i < renumbered.size(); i++) {
+    renumbered[i].seg_id = i;
+
+    if(!entries.emplace(line_segments[i].seg_id, entry{ line_segments[i], {} }).second)
+      throw std::invalid_argument("Duplicate segment id in dynamic_index");
+
+    for_each_cell(line_segments[i], [&](std::uint64_t key) {
+      cells[key].push_back(line_segments[i].seg_id);
+    });
+  }
+
+  // every pair of segments meeting at an intersection crosses there
+  for(auto &it: sweepline::find_intersections(renumbered))
+    for(size_t a = 0; a < it.segments.size(); a++)
+      for(size_t b = a + 1; b < it.segments.size(); b++) {
+        size_t id_a = line_segments[it.segments[a]].seg_id, id_b = line_segments[it.segments[b]].seg_id;
+        entries[id_a].crossings.emplace_back(id_b, it.pt);
+        entries[id_b].crossings.emplace_back(id_a, it.pt);
+      }
+}
+
+template <typename Function>
+void sweepline::dynamic_index::for_each_cell(const geometry::segment_t &seg, Function &&f) const {
+  // segments within EPS of one another intersect, so the segment is widened by EPS on every side,
+  // which also covers the rounding of where it crosses a cell boundary
+  const geometry::float_t margin = geometry::EPS;
+  bool vertical = std::fabs(seg.q.x - seg.p.x) < geometry::EPS;
+
+  std::int64_t min_i = detail::cell_of(seg.p.x - margin, cell_size), max_i = detail::cell_of(seg.q.x + margin, cell_size);
+
+  // walk the columns from left to right, visiting the rows the segment spans within each column
+  for(std::int64_t i = min_i; i <= max_i; i++) {
+    geometry::float_t lo_x = std::clamp<geometry::float_t>(i * cell_size, seg.p.x, seg.q.x);
+    geometry::float_t hi_x = std::clamp<geometry::float_t>((i + 1) * cell_size, seg.p.x, seg.q.x);
+
+    geometry::float_t y1 = vertical? seg.p.y : seg.eval_y(lo_x), y2 = vertical? seg.q.y : seg.eval_y(hi_x);
+    std::int64_t min_j = detail::cell_of(std::min(y1, y2) - margin, cell_size);
+    std::int64_t max_j = detail::cell_of(std::max(y1, y2) + margin, cell_size);
+
+    for(std::int64_t j = min_j; j <= max_j; j++)
+      f(detail::cell_key(i, j));
+  }
+}
+
+geometry::point_t sweepline::dynamic_index::meeting_point(const geometry::segment_t &a, const geometry::segment_t &b) {
+  // an end point on the other segment is exact, and is where the sweep would report it
+  for(auto &[s, t]: { std::pair{ &a, &b }, std::pair{ &b, &a } })
+    for(auto &pt: { s->p, s->q })
+      if(geometry::cross_prod(t->p, t->q, pt) == 0
+        and geometry::can_intersect_1d(pt.x, pt.x, t->p.x, t->q.x)
+        and geometry::can_intersect_1d(pt.y, pt.y, t->p.y, t->q.y))
+          return pt;
+
+  return geometry::intersection_point(a, b);
+}
+
+std::vector<sweepline::intersection_t> sweepline::dynamic_index::insert(const geometry::segment_t &seg) {
+  auto [pos, inserted] = entries.emplace(seg.seg_id, entry{ seg, {} });
+  if(!inserted)
+    throw std::invalid_argument("Duplicate segment id in dynamic_index");
+
+  // only segments sharing a cell with seg can intersect it
+  std::vector<size_t> candidates;
+  for_each_cell(seg, [&](std::uint64_t key) {
+    auto &ids = cells[key];
+    candidates.insert(candidates.end(), ids.begin(), ids.end());
+    ids.push_back(seg.seg_id);
+  });
+
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+  std::vector<sweepline::intersection_t> gained;
+  for(size_t id: candidates) {
+    auto &other = entries[id];
+    if(!geometry::is_intersecting(seg, other.seg))
+      continue;
+
+    geometry::point_t pt = meeting_point(seg, other.seg);
+    pos->second.crossings.emplace_back(id, pt);
+    other.crossings.emplace_back(seg.seg_id, pt);
+    gained.push_back({ pt, { std::min(id, seg.seg_id), std::max(id, seg.seg_id) } });
+  }
+
+  return gained;
+}
+
+std::vector<sweepline::intersection_t> sweepline::dynamic_index::erase(size_t seg_id) {
+  auto pos = entries.find(seg_id);
+  if(pos == entries.end())
+    return {};
+
+  std::vector<sweepline::intersection_t> lost;
+  for(auto &[id, pt]: pos->second.crossings) {
+    lost.push_back({ pt, { std::min(id, seg_id), std::max(id, seg_id) } });
+
+    // every crossing is stored with both of its segments, but a lookup never assumes so
+    auto other = entries.find(id);
+    if(other == entries.end())
+      continue;
+
+    auto &crossings = other->second.crossings;
+    auto crossing = std::find_if(crossings.begin(), crossings.end(),
+      [seg_id = seg_id](const std::pair<size_t, geometry::point_t> &c) { return c.first == seg_id; });
+    if(crossing != crossings.end())
+      crossings.erase(crossing);
+  }
+
+  for_each_cell(pos->second.seg, [&](std::uint64_t key) {
+    auto cell = cells.find(key);
+    if(cell == cells.end())
+      return;
+
+    auto &ids = cell->second;
+    auto itr = std::find(ids.begin(), ids.end(), seg_id);
+    if(itr == ids.end())
+      return;
+
+    *itr = ids.back();
+    ids.pop_back();
+
+    if(ids.empty())
+      cells.erase(cell);
+  });
+
+  entries.erase(pos);
+  return lost;
+}
+
+std::vector<sweepline::intersection_t> sweepline::dynamic_index::intersections() const {
+  std::vector<sweepline::intersection_t> result;
+  for(auto &[seg_id, e]: entries)
+    for(auto &[id, pt]: e.crossings)
+      if(seg_id < id)
+        result.push_back({ pt, { seg_id, id } });
+
+  sweepline::merge_intersection_points(result);
+  return result;
+}
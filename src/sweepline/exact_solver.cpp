@@ -0,0 +1,334 @@
+#include <exact_solver.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+bool sweepline::exact_segment_comparator::operator () (const geometry::exact_line_t &a, const geometry::exact_line_t &b) const {
+  // the point of the sweep lies below every segment through it
+  if(a.seg_id == probe_id)
+    return b.side(*sweep_pt) >= 0;
+  if(b.seg_id == probe_id)
+    return a.side(*sweep_pt) < 0;
+
+  if(int c = geometry::compare_at(a, b, *sweep_pt))
+    return c < 0;
+
+  // segments which meet above the point of the sweep have yet to cross there
+  int s = geometry::compare_slopes(a, b);
+  if(a.side(*sweep_pt) > 0)
+    s = -s;
+
+  return s? s < 0 : a.seg_id < b.seg_id;
+}
+
+template <typename Int>
+sweepline::exact_solver<Int>::exact_solver(const std::vector<geometry::isegment_t<Int>> &line_segments)
+  : line_segments(line_segments) {
+
+    auto in_range = [](Int v) { return -geometry::EXACT_COORD_LIMIT < v and v < geometry::EXACT_COORD_LIMIT; };
+    for(auto &seg: line_segments)
+      if(!in_range(seg.p.x) or !in_range(seg.p.y) or !in_range(seg.q.x) or !in_range(seg.q.y))
+        throw std::out_of_range("coordinates of segment " + std::to_string(seg.seg_id) + " exceed geometry::EXACT_COORD_LIMIT");
+}
+
+template <typename Int>
+std::vector<sweepline::exact_intersection_t> sweepline::exact_solver<Int>::solve() {
+  std::vector<sweepline::exact_intersection_t> result;
+  solve([&result](sweepline::exact_intersection_t &&it) { result.emplace_back(std::move(it)); });
+  return result;
+}
+
+template <typename Int>
+void sweepline::exact_solver<Int>::solve(const sweepline::exact_intersection_sink &sink) {
+  this->sink = &sink;
+  sweep();
+}
+
+template <typename Int>
+sweepline::intersection_count sweepline::exact_solver<Int>::count() {
+  sink = nullptr;
+  counts = { 0, 0 };
+  sweep();
+  return counts;
+}
+
+template <typename Int>
+void sweepline::exact_solver<Int>::sweep() {
+  init_event_queue();
+
+  // sort vertical segments by x then y
+  std::sort(vertical_segs.begin(), vertical_segs.end(),
+    [](const geometry::isegment_t<Int> &a, const geometry::isegment_t<Int> &b) {
+      return a.p.x == b.p.x? a.p.y < b.p.y : a.p.x < b.p.x;
+    }
+  );
+
+  find_vertical_vertical_intersections();
+
+  while(!event_queue.empty()) {
+    geometry::rational_point_t cur = event_queue.begin()->p;
+
+    // pop all events at cur, only the segments which begin here are not already in the segment ordering
+    begins.clear();
+    while(!event_queue.empty() and event_queue.begin()->p == cur) {
+      if(event_queue.begin()->tp == sweepline::event_t::type::begin)
+        begins.push_back(event_queue.begin()->seg_id);
+      event_queue.erase(event_queue.begin());
+    }
+
+    // vertical segments behind cur have seen all their events, and so have the intersections there
+    find_vertical_nonvertical_intersections(cur);
+    flush_intersections(cur);
+
+    sweep_pt = cur;
+    handle_event(cur, begins);
+  }
+
+  find_vertical_nonvertical_intersections(geometry::rational_point_t::infinity());
+  flush_intersections(geometry::rational_point_t::infinity());
+
+  // left ready for another run
+  vert_idx = vert_vert_idx = 0;
+  lines.clear();
+  vertical_segs.clear();
+  vertical_intersections.clear();
+  vertical_ids.clear();
+}
+
+template <typename Int>
+void sweepline::exact_solver<Int>::init_event_queue() {
+  lines.reserve(line_segments.size());
+  endpoints.clear();
+  endpoints.reserve(2 * line_segments.size());
+
+  for(size_t i = 0; i < line_segments.size(); i++) {
+    const auto &seg = line_segments[i];
+    lines.push_back(geometry::exact_line_t::through(seg));
+
+    if(seg.p.x == seg.q.x)
+      vertical_segs.push_back(seg);
+    else {
+      endpoints.push_back({ geometry::rational_point_t::from(seg.p), sweepline::event_t::type::begin, i });
+      endpoints.push_back({ geometry::rational_point_t::from(seg.q), sweepline::event_t::type::end, i });
+    }
+  }
+
+  // sorted, the end points are built into the event queue in linear time rather than inserted one by one
+  std::sort(endpoints.begin(), endpoints.end());
+  event_queue.insert(endpoints.begin(), endpoints.end());
+}
+
+template <typename Int>
+void sweepline::exact_solver<Int>::find_vertical_vertical_intersections() {
+  for(size_t i = 0; i + 1 < vertical_segs.size(); i++) {
+    if(vertical_segs[i].q == vertical_segs[i + 1].p) {
+      vertical_intersections.push_back({
+        geometry::rational_point_t::from(vertical_segs[i].q), vertical_ids.size(), vertical_ids.size() + 2 });
+      vertical_ids.push_back(vertical_segs[i].seg_id);
+      vertical_ids.push_back(vertical_segs[i + 1].seg_id);
+    }
+  }
+}
+
+template <typename Int>
+void sweepline::exact_solver<Int>::find_vertical_nonvertical_intersections(const geometry::rational_point_t &before) {
+  for(; vert_idx < vertical_segs.size() and before.compare_x(vertical_segs[vert_idx].p.x) > 0; vert_idx++) {
+    auto &vseg = vertical_segs[vert_idx];
+
+    // the segments crossing the vertical segment follow the lowest one at or above its bottom
+    sweep_pt = geometry::rational_point_t::from(vseg.p);
+    auto itr = seg_ordering.lower_bound(geometry::exact_line_t::probe());
+
+    geometry::rational_point_t top = geometry::rational_point_t::from(vseg.q);
+    for(; itr != seg_ordering.end() and itr->side(top) <= 0; ++itr) {
+      pending_ids.push_back(itr->seg_id);
+      pending_ids.push_back(vseg.seg_id);
+      add_pending(itr->at(vseg.p.x), pending_ids.size() - 2);
+    }
+  }
+}
+
+template <typename Int>
+void sweepline::exact_solver<Int>::handle_event(const geometry::rational_point_t &cur, const std::vector<size_t> &begins) {
+  // the segments through cur form a run, which is taken out to be put back in their order past cur,
+  // in the same nodes so that their lines are neither copied nor allocated again
+  through.clear();
+  through_nodes.clear();
+  auto itr = seg_ordering.lower_bound(geometry::exact_line_t::probe());
+  while(itr != seg_ordering.end() and itr->side(cur) == 0) {
+    through.push_back(itr->seg_id);
+    through_nodes.push_back(seg_ordering.extract(itr++));
+  }
+
+  size_t first = pending_ids.size();
+  pending_ids.insert(pending_ids.end(), through.begin(), through.end());
+  pending_ids.insert(pending_ids.end(), begins.begin(), begins.end());
+
+  // vertical segments through cur, of which there are two at most, touching at cur
+  auto vbegin = vertical_segs.begin() + vert_idx;
+  auto vpos = std::upper_bound(vbegin, vertical_segs.end(), cur,
+    [](const geometry::rational_point_t &pt, const geometry::isegment_t<Int> &vseg) {
+      int cx = pt.compare_x(vseg.p.x);
+      return cx? cx < 0 : pt.compare_y(vseg.p.y) < 0;
+    }
+  );
+  for(int k = 0; k < 2 and vpos != vbegin; k++) {
+    --vpos;
+    if(cur.compare_x(vpos->p.x) != 0 or cur.compare_y(vpos->q.y) > 0)
+      break;
+    pending_ids.push_back(vpos->seg_id);
+  }
+
+  if(pending_ids.size() - first > 1)
+    add_pending(cur, first);
+  else
+    pending_ids.resize(first);
+
+  // put back the segments which go on past cur, and insert those which begin here
+  const sweepline::exact_segment_comparator cmp { &sweep_pt };
+  auto lo = seg_ordering.end(), hi = seg_ordering.end();
+  auto extend = [&](auto pos) {
+    if(lo == seg_ordering.end() or cmp(*pos, *lo))
+      lo = pos;
+    if(hi == seg_ordering.end() or cmp(*hi, *pos))
+      hi = pos;
+  };
+
+  for(auto &nh: through_nodes)
+    if(!(cur == line_segments[nh.value().seg_id].q))
+      extend(seg_ordering.insert(std::move(nh)).position);
+  through_nodes.clear();
+
+  for(size_t idx: begins)
+    extend(seg_ordering.insert(lines[idx]).first);
+
+  if(lo == seg_ordering.end()) {
+    // the neighbours of the removed run become adjacent
+    if(itr != seg_ordering.end() and itr != seg_ordering.begin()) {
+      auto below = itr;
+      --below;
+      find_new_event(*below, *itr, cur);
+    }
+    return;
+  }
+
+  if(lo != seg_ordering.begin()) {
+    auto below = lo;
+    --below;
+    find_new_event(*below, *lo, cur);
+  }
+
+  auto above = hi;
+  ++above;
+  if(above != seg_ordering.end())
+    find_new_event(*hi, *above, cur);
+}
+
+template <typename Int>
+void sweepline::exact_solver<Int>::find_new_event(
+  const geometry::exact_line_t &below,
+  const geometry::exact_line_t &above,
+  const geometry::rational_point_t &cur
+) {
+
+  // only segments which close in on each other past cur can cross there
+  if(geometry::compare_slopes(below, above) <= 0)
+    return;
+
+  geometry::rational_point_t pt = geometry::meet(below, above);
+  if(pt.compare(cur) <= 0
+    or pt.compare_x(line_segments[below.seg_id].q.x) > 0
+    or pt.compare_x(line_segments[above.seg_id].q.x) > 0)
+      return;
+
+  // all segments through pt are found there, so one event is enough
+  event_queue.insert({ pt, sweepline::event_t::type::interior, below.seg_id });
+}
+
+template <typename Int>
+void sweepline::exact_solver<Int>::flush_intersections(const geometry::rational_point_t &before) {
+  // vertical<->vertical intersections were all found up front, they join in as the sweep reaches them
+  for(; vert_vert_idx < vertical_intersections.size()
+    and vertical_intersections[vert_vert_idx].pt.compare_x(before) < 0; vert_vert_idx++) {
+
+      auto &it = vertical_intersections[vert_vert_idx];
+      size_t first = pending_ids.size();
+      pending_ids.insert(pending_ids.end(), vertical_ids.begin() + it.first, vertical_ids.begin() + it.last);
+      add_pending(it.pt, first);
+  }
+
+  // nothing to pass on yet, e.g. while many intersections share the x coordinate of the sweep
+  if(pending.empty() or pending_min.compare_x(before) >= 0)
+    return;
+
+  std::sort(pending.begin(), pending.end(), [](const found_t &a, const found_t &b) { return a.pt < b.pt; });
+
+  size_t i = 0;
+  while(i < pending.size() and pending[i].pt.compare_x(before) < 0) {
+    merged_ids.clear();
+
+    size_t j = i;
+    for(; j < pending.size() and pending[j].pt == pending[i].pt; j++)
+      merged_ids.insert(merged_ids.end(), pending_ids.begin() + pending[j].first, pending_ids.begin() + pending[j].last);
+
+    std::sort(merged_ids.begin(), merged_ids.end());
+    merged_ids.erase(std::unique(merged_ids.begin(), merged_ids.end()), merged_ids.end());
+
+    if(sink)
+      (*sink)(sweepline::exact_intersection_t{ pending[i].pt, merged_ids });
+    else
+      counts.num_points++, counts.num_pairs += merged_ids.size() * (merged_ids.size() - 1) / 2;
+
+    i = j;
+  }
+
+  pending.erase(pending.begin(), pending.begin() + i);
+
+  // compact the segments of the intersections still pending
+  merged_ids.clear();
+  pending_min = geometry::rational_point_t::infinity();
+  for(auto &it: pending) {
+    size_t first = merged_ids.size();
+    merged_ids.insert(merged_ids.end(), pending_ids.begin() + it.first, pending_ids.begin() + it.last);
+    it.first = first, it.last = merged_ids.size();
+    if(it.pt.compare_x(pending_min) < 0)
+      pending_min = it.pt;
+  }
+  pending_ids.swap(merged_ids);
+}
+
+template <typename Int>
+void sweepline::exact_solver<Int>::add_pending(const geometry::rational_point_t &pt, size_t first) {
+  pending.push_back({ pt, first, pending_ids.size() });
+  if(pt.compare_x(pending_min) < 0)
+    pending_min = pt;
+}
+
+template <typename Int>
+std::vector<sweepline::exact_intersection_t> sweepline::find_intersections(
+  const std::vector<geometry::isegment_t<Int>> &line_segments
+) {
+
+  return sweepline::exact_solver<Int>(line_segments).solve();
+}
+
+template <typename Int>
+sweepline::intersection_count sweepline::count_intersections(
+  const std::vector<geometry::isegment_t<Int>> &line_segments
+) {
+
+  return sweepline::exact_solver<Int>(line_segments).count();
+}
+
+template class sweepline::exact_solver<std::int32_t>;
+template class sweepline::exact_solver<std::int64_t>;
+
+template std::vector<sweepline::exact_intersection_t> sweepline::find_intersections(
+  const std::vector<geometry::isegment_t<std::int32_t>> &);
+template std::vector<sweepline::exact_intersection_t> sweepline::find_intersections(
+  const std::vector<geometry::isegment_t<std::int64_t>> &);
+template sweepline::intersection_count sweepline::count_intersections(
+  const std::vector<geometry::isegment_t<std::int32_t>> &);
+template sweepline::intersection_count sweepline::count_intersections(
+  const std::vector<geometry::isegment_t<std::int64_t>> &);
@@ -0,0 +1,256 @@
+#include <sweepline.hpp>
+#include <thread_pool.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+// This namespace is meant to be hidden from the API
+// provides implementation of the slab decomposition
+namespace detail {
+
+  /// Number of slabs per thread, a few more slabs than threads evens out the load
+  constexpr size_t slabs_per_thread = 2;
+
+  /// Slab boundaries are kept at least this far away from any end point, in the frame every slab is swept in
+  constexpr geometry::float_t min_gap = 4 * geometry::EPS_INC;
+
+  /**
+   * Picks up to (num_slabs - 1) increasing x coordinates which split the work into slabs of
+   * roughly equal size. Every end point carries a unit of work, and every segment spreads
+   * another unit evenly over its x-extent for the intersections along it, so inputs made of
+   * long segments are split too. Boundaries are then moved into the nearest gap between
+   * consecutive end points, so no event ever lies on a boundary.
+   */
+  std::vector<geometry::float_t> slab_boundaries(
+    const std::vector<geometry::segment_t> &line_segments,
+    const sweepline::basic_frame<geometry::float_t> &frame,
+    size_t num_slabs
+  ) {
+
+    // the tolerances hold in the frame, so they are scaled back to the coordinates of the input
+    const geometry::float_t gap = min_gap / frame.scale;
+
+    struct breakpoint {
+      geometry::float_t x;      // x coordinate of an end point
+      geometry::float_t mass;   // work carried by the end point itself
+      geometry::float_t slope;  // change in work per unit of x past the end point
+    };
+
+    std::vector<breakpoint> profile;
+    profile.reserve(2 * line_segments.size());
+    for(auto &seg: line_segments) {
+      geometry::float_t len = seg.q.x - seg.p.x;
+      if(frame.local_x(seg.q.x) - frame.local_x(seg.p.x) < geometry::EPS)
+        profile.push_back({ seg.p.x, 2, 0 }), profile.push_back({ seg.q.x, 1, 0 });
+      else
+        profile.push_back({ seg.p.x, 1, 1 / len }), profile.push_back({ seg.q.x, 1, -1 / len });
+    }
+    std::sort(profile.begin(), profile.end(),
+      [](const breakpoint &a, const breakpoint &b) { return a.x < b.x; });
+
+    std::vector<geometry::float_t> xs(profile.size());
+    for(size_t i = 0; i < profile.size(); i++)
+      xs[i] = profile[i].x;
+
+    // whether a boundary fits between the end points xs[j - 1] and xs[j]
+    auto fits = [&](size_t j) {
+      return 0 < j and j < xs.size() and xs[j] - xs[j - 1] > gap;
+    };
+
+    // moves x into the nearest gap wide enough to hold a boundary
+    auto settle = [&](geometry::float_t x) {
+      size_t ideal = std::lower_bound(xs.begin(), xs.end(), x) - xs.begin();
+      if(fits(ideal))
+        return std::clamp(x, xs[ideal - 1] + gap / 2, xs[ideal] - gap / 2);
+
+      for(size_t d = 1; d < xs.size(); d++) {
+        size_t j = fits(ideal + d)? ideal + d : d <= ideal and fits(ideal - d)? ideal - d : 0;
+        if(j)
+          return (xs[j - 1] + xs[j]) / 2;
+      }
+
+      return std::numeric_limits<geometry::float_t>::quiet_NaN();
+    };
+
+    std::vector<geometry::float_t> boundaries;
+    auto add_boundary = [&](geometry::float_t x) {
+      x = settle(x);
+      if(!std::isnan(x) and (boundaries.empty() or boundaries.back() < x))
+        boundaries.push_back(x);
+    };
+
+    // walk the cumulative work from left to right and cut it at every multiple of total / num_slabs
+    geometry::float_t total = 3 * line_segments.size(), done = 0, density = 0;
+    size_t k = 1;
+    for(size_t i = 0; i < profile.size() and k < num_slabs; i++) {
+      if(i > 0) {
+        geometry::float_t prev_x = profile[i - 1].x, spread = density * (profile[i].x - prev_x);
+        for(; k < num_slabs and k * total / num_slabs < done + spread; k++)
+          add_boundary(prev_x + (k * total / num_slabs - done) / density);
+        done += spread;
+      }
+
+      done += profile[i].mass;
+      for(; k < num_slabs and k * total / num_slabs < done; k++)
+        add_boundary(profile[i].x);
+      density += profile[i].slope;
+    }
+
+    return boundaries;
+  }
+
+  /// Intersections this close to a slab boundary, in the frame every slab is swept in, may have been found by both
+  /// of its slabs, or lie within EPS of one another across it
+  constexpr geometry::float_t seam_width = 2 * geometry::EPS_INC;
+
+  /**
+   * Picks the slab boundaries for num_threads threads, 0 picking one per hardware thread,
+   * none if a single thread is asked for or the input cannot be split.
+   */
+  std::vector<geometry::float_t> parallel_boundaries(
+    const std::vector<geometry::segment_t> &line_segments,
+    const sweepline::basic_frame<geometry::float_t> &frame,
+    size_t &num_threads
+  ) {
+
+    if(num_threads == 0)
+      num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    if(num_threads == 1)
+      return {};
+
+    return slab_boundaries(line_segments, frame, num_threads * slabs_per_thread);
+  }
+
+  /**
+   * Sweeps every slab between the boundaries independently on a thread pool, each into a list of its own,
+   * and concatenates the lists. Only the intersections within seam_width of a boundary are built into
+   * intersection_t and merged, the rest are copied over as they are. Every slab is swept in \a frame,
+   * fitted to the whole input, and the seams are merged in it too, so the slabs agree with a single sweep.
+   */
+  sweepline::intersection_list sweep_slabs(
+    const std::vector<geometry::segment_t> &line_segments,
+    const sweepline::basic_frame<geometry::float_t> &frame,
+    const std::vector<geometry::float_t> &boundaries,
+    size_t num_threads
+  ) {
+
+    size_t num_slabs = boundaries.size() + 1;
+    const geometry::float_t width = seam_width / frame.scale;
+
+    // the slab containing x, slab s spans [boundaries[s - 1], boundaries[s])
+    auto slab_of = [&](geometry::float_t x) -> size_t {
+      return std::upper_bound(boundaries.begin(), boundaries.end(), x) - boundaries.begin();
+    };
+
+    // distribute the segments among the slabs they overlap, renumbered to be local to each slab
+    std::vector<std::vector<geometry::segment_t>> slab_segs(num_slabs);
+    std::vector<std::vector<std::uint32_t>> slab_ids(num_slabs);   // local id -> seg_id in the input
+
+    for(auto &seg: line_segments) {
+      size_t first = slab_of(seg.p.x), last = slab_of(seg.q.x);
+      if(std::fabs(frame.local_x(seg.p.x) - frame.local_x(seg.q.x)) < geometry::EPS)
+        last = first;
+
+      for(size_t s = first; s <= last; s++) {
+        slab_segs[s].push_back(geometry::segment_t{ seg.p, seg.q, slab_segs[s].size() });
+        slab_ids[s].push_back(std::uint32_t(seg.seg_id));
+      }
+    }
+
+    // sweep every slab independently, appending to a list of its own
+    std::vector<sweepline::intersection_list> slab_lists(num_slabs);
+
+    sweepline::thread_pool pool(std::min(num_threads, num_slabs));
+    pool.run(num_slabs, [&](size_t s) {
+      geometry::float_t slab_begin = s == 0? -std::numeric_limits<geometry::float_t>::max() : boundaries[s - 1];
+      geometry::float_t slab_end = s + 1 == num_slabs? std::numeric_limits<geometry::float_t>::max() : boundaries[s];
+
+      sweepline::solver(slab_segs[s], slab_begin, slab_end, 0, frame).solve(slab_lists[s]);
+
+      for(std::uint32_t &idx: slab_lists[s].ids)
+        idx = slab_ids[s][idx];
+    });
+
+    // concatenate the slabs, every slab is in order already
+    sweepline::intersection_list result;
+    size_t num_points = 0, num_ids = 0;
+    for(auto &list: slab_lists)
+      num_points += list.size(), num_ids += list.ids.size();
+
+    result.points.reserve(num_points);
+    result.offsets.reserve(num_points + 1);
+    result.ids.reserve(num_ids);
+
+    // except around a boundary, where intersections found by both slabs are merged
+    std::vector<sweepline::intersection_t> seam;
+    for(size_t s = 0; s < num_slabs; s++) {
+      auto &list = slab_lists[s];
+
+      size_t first = 0;
+      if(s > 0) {
+        for(; first < list.size() and list.points[first].x < boundaries[s - 1] + width; first++)
+          seam.push_back(list.at(first));
+
+        // points are merged within EPS in the frame, as a single sweep merges them
+        for(auto &it: seam)
+          it.pt = frame.to_local(it.pt);
+        sweepline::merge_intersection_points(seam);
+        for(auto &it: seam)
+          result.push_back(frame.to_world(it.pt), it.segments.begin(), it.segments.end());
+        seam.clear();
+      }
+
+      size_t last = list.size();
+      if(s + 1 < num_slabs)
+        while(last > first and list.points[last - 1].x > boundaries[s] - width)
+          last--;
+
+      for(size_t i = first; i < last; i++)
+        result.push_back(list.points[i], list.segments_begin(i), list.segments_end(i));
+
+      for(size_t i = last; i < list.size(); i++)
+        seam.push_back(list.at(i));
+    }
+
+    return result;
+  }
+
+} // namespace detail
+
+std::vector<sweepline::intersection_t> sweepline::find_intersections_parallel(
+  const std::vector<geometry::segment_t> &line_segments,
+  size_t num_threads
+) {
+
+  auto frame = sweepline::basic_frame<geometry::float_t>::fit(line_segments);
+  auto boundaries = detail::parallel_boundaries(line_segments, frame, num_threads);
+  if(boundaries.empty())
+    return sweepline::find_intersections(line_segments);
+
+  auto list = detail::sweep_slabs(line_segments, frame, boundaries, num_threads);
+
+  std::vector<sweepline::intersection_t> result;
+  result.reserve(list.size());
+  for(size_t i = 0; i < list.size(); i++)
+    result.push_back(list.at(i));
+
+  return result;
+}
+
+sweepline::intersection_list sweepline::find_intersection_list_parallel(
+  const std::vector<geometry::segment_t> &line_segments,
+  size_t num_threads
+) {
+
+  auto frame = sweepline::basic_frame<geometry::float_t>::fit(line_segments);
+  auto boundaries = detail::parallel_boundaries(line_segments, frame, num_threads);
+  if(boundaries.empty())
+    return sweepline::find_intersection_list(line_segments);
+
+  return detail::sweep_slabs(line_segments, frame, boundaries, num_threads);
+}
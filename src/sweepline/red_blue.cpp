@@ -0,0 +1,81 @@
+#include <sweepline.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+// This namespace is meant to be hidden from the API
+// provides implementation of the bichromatic mode
+namespace detail {
+
+  /// The sweep is kept this far past the x-range shared by both colours, so no event lies on its boundary
+  constexpr geometry::float_t range_margin = 4 * geometry::EPS_INC;
+
+  /// An axis aligned bounding box
+  struct bounding_box {
+    geometry::float_t min_x = std::numeric_limits<geometry::float_t>::max();
+    geometry::float_t max_x = -std::numeric_limits<geometry::float_t>::max();
+    geometry::float_t min_y = std::numeric_limits<geometry::float_t>::max();
+    geometry::float_t max_y = -std::numeric_limits<geometry::float_t>::max();
+
+    void add(const geometry::segment_t &seg) {
+      min_x = std::min(min_x, seg.p.x), max_x = std::max(max_x, seg.q.x);
+      min_y = std::min({ min_y, seg.p.y, seg.q.y }), max_y = std::max({ max_y, seg.p.y, seg.q.y });
+    }
+
+    bool overlaps(const geometry::segment_t &seg) const {
+      return seg.p.x <= max_x + geometry::EPS and min_x - geometry::EPS <= seg.q.x
+        and std::min(seg.p.y, seg.q.y) <= max_y + geometry::EPS
+        and min_y - geometry::EPS <= std::max(seg.p.y, seg.q.y);
+    }
+  };
+
+} // namespace detail
+
+std::vector<sweepline::intersection_t> sweepline::find_red_blue_intersections(
+  const std::vector<geometry::segment_t> &red,
+  const std::vector<geometry::segment_t> &blue
+) {
+
+  detail::bounding_box red_box, blue_box;
+  for(auto &seg: red)
+    red_box.add(seg);
+  for(auto &seg: blue)
+    blue_box.add(seg);
+
+  // only segments which reach into the bounding box of the other colour can cross it,
+  // they are renumbered with the red ones first so the solver can tell the colours apart
+  std::vector<geometry::segment_t> line_segments;
+  std::vector<size_t> ids;    // local id -> id in red followed by blue
+
+  for(size_t i = 0; i < red.size(); i++)
+    if(blue_box.overlaps(red[i])) {
+      line_segments.push_back(geometry::segment_t{ red[i].p, red[i].q, line_segments.size() });
+      ids.push_back(i);
+    }
+
+  size_t num_red = line_segments.size();
+
+  for(size_t j = 0; j < blue.size(); j++)
+    if(red_box.overlaps(blue[j])) {
+      line_segments.push_back(geometry::segment_t{ blue[j].p, blue[j].q, line_segments.size() });
+      ids.push_back(red.size() + j);
+    }
+
+  if(num_red == 0 or num_red == line_segments.size())
+    return {};
+
+  // a crossing of both colours lies where both have segments, so the sweep is restricted to that slab
+  geometry::float_t slab_begin = std::max(red_box.min_x, blue_box.min_x) - detail::range_margin;
+  geometry::float_t slab_end = std::min(red_box.max_x, blue_box.max_x) + detail::range_margin;
+
+  std::vector<sweepline::intersection_t> result
+    = sweepline::solver(line_segments, slab_begin, slab_end, num_red).solve();
+
+  // ids are renumbered in order, so the segments of each intersection stay sorted
+  for(auto &it: result)
+    for(size_t &idx: it.segments)
+      idx = ids[idx];
+
+  return result;
+}
@@ -9,14 +9,21 @@
 #include <array>
 #include <vector>
 #include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
 
 #define format_col(enable_color, ts, argn...) \
   fmt::format((enable_color? ts : fmt::v8::text_style()), argn)
 
 // This namespace is meant to be hidden from the API
-// provides implementation of debugging utility functions
+// provides implementation of debugging utility functions and of merging intersections
 namespace detail {
-  bool enable_color = true;
+  thread_local bool enable_color = true;
+
+  /// Segments are clipped to a query window enlarged by this much, so no clipped end point lies on the window
+  template <typename T>
+  constexpr T window_margin = 4 * 5 * geometry::tolerance<T>;
 
   std::array<fmt::color, 3> type_col {
     fmt::color::light_sea_green,  // sweepline::event_t::type::begin
@@ -46,12 +53,14 @@ namespace detail {
     return format_col(enable_color, fmt::emphasis::bold | fg(fmt::color::khaki), "{}", id);
   }
 
-  std::string format_point(const geometry::point_t &p) {
+  template <typename T>
+  std::string format_point(const geometry::basic_point<T> &p) {
     return format_col(enable_color, fmt::emphasis::faint | fg(fmt::color::medium_aquamarine),
             "({:.3f}, {:.3f})", p.x, p.y);
   }
 
-  std::string format_event(const sweepline::event_t &e) {
+  template <typename T>
+  std::string format_event(const sweepline::basic_event<T> &e) {
     return fmt::format("<{}, {}, {}>",
       format_point(e.p),
       format_event_type(e.tp),
@@ -60,7 +69,8 @@ namespace detail {
     );
   }
 
-  std::string format_segment(const geometry::segment_t &s) {
+  template <typename T>
+  std::string format_segment(const geometry::basic_segment<T> &s) {
     return fmt::format("[{}, {}, {}]",
       format_point(s.p),
       format_point(s.q),
@@ -69,7 +79,8 @@ namespace detail {
     );
   }
 
-  std::string format_intersection(const sweepline::intersection_t &it) {
+  template <typename T>
+  std::string format_intersection(const sweepline::basic_intersection<T> &it) {
     std::string res = fmt::format("  {}  ", format_point(it.pt));
 
     bool fst = true;
@@ -88,14 +99,16 @@ namespace detail {
     debug_line();
   }
 
-  void debug_line_segments(const std::vector<geometry::segment_t> &line_segments) {
+  template <typename T>
+  void debug_line_segments(const sweepline::basic_segment_table<T> &line_segments) {
     std::cerr << detail::format_subheading_text("line_segments") << " = {\n";
-    for(auto &x: line_segments)
-      std::cerr << '\t' << detail::format_segment(x) << ',' << std::endl;
+    for(size_t i = 0; i < line_segments.size(); i++)
+      std::cerr << '\t' << detail::format_segment(line_segments.segment(i)) << ',' << std::endl;
     std::cerr << '}' << std::endl << std::endl;
   }
 
-  void debug_vertical_segs(const std::vector<geometry::segment_t> &vertical_segs) {
+  template <typename T>
+  void debug_vertical_segs(const std::vector<geometry::basic_segment<T>> &vertical_segs) {
     std::cerr << detail::format_subheading_text("vertical_segs") << " = {";
     bool fst = false;
     for(auto &x: vertical_segs)
@@ -103,16 +116,18 @@ namespace detail {
     std::cerr << '}' << std::endl;
   }
 
-  void debug_intersection(const sweepline::intersection_t &it, std::string type = "") {
+  template <typename T>
+  void debug_intersection(const sweepline::basic_intersection<T> &it, std::string type = "") {
     std::cerr << detail::format_neutral_text("\nFound " + type + " intersection!\n");
     std::cerr << detail::format_intersection(it) << std::endl;
   }
 
+  template <typename T>
   void debug_initial(
-    geometry::float_t sweeplineX,
-    sweepline::event_t top,
-    const sweepline::bbst<sweepline::event_t> &event_queue,
-    const sweepline::bbst<geometry::segment_t> &seg_ordering) {
+    T sweeplineX,
+    sweepline::basic_event<T> top,
+    const std::vector<sweepline::basic_event<T>> &event_queue,
+    const sweepline::bbst<std::uint32_t, sweepline::basic_segment_comparator<T>> &seg_ordering) {
 
     std::cerr << detail::format_heading_text("sweeplineX") << " = " << sweeplineX << std::endl << std::endl;
     std::cerr << detail::format_neutral_text("initially:\n");
@@ -127,15 +142,16 @@ namespace detail {
     {
       bool fst = true;
       for(auto &x: seg_ordering)
-        std::cerr << (fst? "" : ", ") << detail::format_id(x.seg_id + 1), fst = false;
+        std::cerr << (fst? "" : ", ") << detail::format_id(x + 1), fst = false;
       std::cerr << '}' << std::endl;
     }
     std::cerr << std::endl;
   }
 
+  template <typename T>
   void debug_final(
-    const sweepline::bbst<sweepline::event_t> &event_queue,
-    const sweepline::bbst<geometry::segment_t> &seg_ordering) {
+    const std::vector<sweepline::basic_event<T>> &event_queue,
+    const sweepline::bbst<std::uint32_t, sweepline::basic_segment_comparator<T>> &seg_ordering) {
 
     std::cerr << detail::format_neutral_text("\nfinally:\n");
 
@@ -151,14 +167,15 @@ namespace detail {
     {
       bool fst = true;
       for(auto &x: seg_ordering)
-        std::cerr << (fst? "" : ", ") << detail::format_id(x.seg_id + 1), fst = false;
+        std::cerr << (fst? "" : ", ") << detail::format_id(x + 1), fst = false;
       std::cerr << '}' << std::endl;
     }
 
     debug_line();
   }
 
-  void debug_active_events(sweepline::event_t top, const std::array<std::vector<size_t>, 3> &active) {
+  template <typename T>
+  void debug_active_events(sweepline::basic_event<T> top, const std::array<std::vector<size_t>, 3> &active) {
     std::cerr << format_col(enable_color, fg(fmt::color::gold), "active point")
                 << " -> " << detail::format_point(top.p) << std::endl;
     {
@@ -196,6 +213,32 @@ namespace detail {
 
   }
 
+  // sorts intersections by x and then y coordinate of their points
+  template <typename Intersection>
+  void sort_by_point(std::vector<Intersection> &intersections) {
+    std::sort(intersections.begin(), intersections.end(),
+      [](const Intersection &a, const Intersection &b) {
+        return a.pt.x == b.pt.x? a.pt.y < b.pt.y : a.pt.x < b.pt.x;
+      }
+    );
+  }
+
+  // merges the sorted run of intersections with the same point as intersections[i] into merged,
+  // with the union of their segments sorted by id, and returns the index past the run
+  size_t merge_run(std::vector<sweepline::intersection_t> &intersections, size_t i, sweepline::intersection_t &merged) {
+    merged = std::move(intersections[i]);
+
+    size_t j = i + 1;
+    for(; j < intersections.size() and intersections[j].pt == merged.pt; j++)
+      merged.segments.insert(merged.segments.end(),
+        intersections[j].segments.begin(), intersections[j].segments.end());
+
+    std::sort(merged.segments.begin(), merged.segments.end());
+    merged.segments.erase(std::unique(merged.segments.begin(), merged.segments.end()), merged.segments.end());
+
+    return j;
+  }
+
 } // namespace detail
 
 std::vector<sweepline::intersection_t> sweepline::find_intersections(
@@ -207,17 +250,187 @@ std::vector<sweepline::intersection_t> sweepline::find_intersections(
   return sweepline::solver(line_segments, verbose, enable_color).solve();
 }
 
-geometry::float_t sweepline::sweeplineX;
+std::vector<sweepline::basic_intersection<float>> sweepline::find_intersections(
+  const std::vector<geometry::basic_segment<float>> &line_segments,
+  bool verbose,
+  bool enable_color
+) {
+
+  return sweepline::basic_solver<float>(line_segments, verbose, enable_color).solve();
+}
+
+std::optional<sweepline::intersection_t> sweepline::any_intersection(
+  const std::vector<geometry::segment_t> &line_segments,
+  bool verbose,
+  bool enable_color
+) {
+
+  return sweepline::solver(line_segments, verbose, enable_color).any_intersection();
+}
+
+std::vector<sweepline::intersection_t> sweepline::find_intersections(
+  const std::vector<geometry::segment_t> &line_segments,
+  const sweepline::query_window &window
+) {
+
+  return sweepline::solver(line_segments, window).solve();
+}
+
+sweepline::intersection_list sweepline::find_intersection_list(
+  const std::vector<geometry::segment_t> &line_segments,
+  bool verbose,
+  bool enable_color
+) {
+
+  sweepline::intersection_list result;
+  sweepline::solver(line_segments, verbose, enable_color).solve(result);
+  return result;
+}
+
+sweepline::intersection_count sweepline::count_intersections(
+  const std::vector<geometry::segment_t> &line_segments,
+  bool verbose,
+  bool enable_color
+) {
+
+  return sweepline::solver(line_segments, verbose, enable_color).count();
+}
+
+sweepline::intersection_count sweepline::count_intersections(
+  const std::vector<geometry::basic_segment<float>> &line_segments,
+  bool verbose,
+  bool enable_color
+) {
+
+  return sweepline::basic_solver<float>(line_segments, verbose, enable_color).count();
+}
+
+template <typename T>
+bool sweepline::basic_segment_comparator<T>::operator () (std::uint32_t a, std::uint32_t b) const {
+#ifdef SWEEPLINE_STATS
+  num_calls++;
+#endif
+
+  T ya = segments->eval_y(a, *sweeplineX), yb = segments->eval_y(b, *sweeplineX);
+  if(std::fabs(ya - yb) > geometry::tolerance<T>)
+    return ya < yb;
+
+  // segments meeting at the sweepline are ordered as they are just past it
+  return segments->slopes[a] < segments->slopes[b];
+}
 
-sweepline::solver::solver(const std::vector<geometry::segment_t> &line_segments, bool verbose, bool enable_color)
-  : line_segments(line_segments), verbose(verbose) {
+template <typename T, typename EventQueue>
+sweepline::basic_solver<T, EventQueue>::basic_solver(const std::vector<segment> &line_segments, bool verbose, bool enable_color)
+  : verbose(verbose), frame(basic_frame<T>::fit(line_segments)) {
 
+    this->line_segments.assign(line_segments, frame);
     detail::enable_color = enable_color;  // set/unset color printing
 }
 
-std::vector<sweepline::intersection_t> sweepline::solver::solve() {
+template <typename T, typename EventQueue>
+sweepline::basic_solver<T, EventQueue>::basic_solver(
+  const std::vector<segment> &line_segments,
+  T slab_begin,
+  T slab_end,
+  size_t num_red,
+  const std::optional<basic_frame<T>> &frame
+) : verbose(false), frame(frame? *frame : basic_frame<T>::fit(line_segments)), num_red(num_red),
+    slab_begin(this->frame.local_x(slab_begin)), slab_end(this->frame.local_x(slab_end)) {
+
+    this->line_segments.assign(line_segments, this->frame);
+}
+
+template <typename T, typename EventQueue>
+sweepline::basic_solver<T, EventQueue>::basic_solver(const std::vector<segment> &line_segments, const sweepline::basic_query_window<T> &window)
+  : verbose(false), frame(basic_frame<T>::fit(line_segments)),
+    window(basic_query_window<T>{ frame.to_local(window.lo), frame.to_local(window.hi) }),
+    slab_begin(this->window->lo.x - detail::window_margin<T>), slab_end(this->window->hi.x + detail::window_margin<T>),
+    clip_lo_y(this->window->lo.y - detail::window_margin<T>), clip_hi_y(this->window->hi.y + detail::window_margin<T>) {
+
+    this->line_segments.assign(line_segments, frame);
+}
+
+template <typename T, typename EventQueue>
+std::vector<sweepline::basic_intersection<T>> sweepline::basic_solver<T, EventQueue>::solve() {
+  std::vector<intersection> result;
+  solve([&result](intersection &&it) { result.emplace_back(std::move(it)); });
+  return result;
+}
+
+template <typename T, typename EventQueue>
+void sweepline::basic_solver<T, EventQueue>::solve(const sweepline::basic_intersection_sink<T> &sink) {
+  this->sink = &sink;
+  list = nullptr;
+  sweep();
+}
+
+template <typename T, typename EventQueue>
+void sweepline::basic_solver<T, EventQueue>::solve(sweepline::basic_intersection_list<T> &result) {
+  result.clear();
+  sink = nullptr;
+  list = &result;
+  sweep();
+  list = nullptr;
+}
+
+template <typename T, typename EventQueue>
+sweepline::intersection_count sweepline::basic_solver<T, EventQueue>::count() {
+  sink = nullptr;
+  list = nullptr;
+  counts = { 0, 0 };
+  sweep();
+  return counts;
+}
+
+template <typename T, typename EventQueue>
+std::optional<sweepline::basic_intersection<T>> sweepline::basic_solver<T, EventQueue>::any_intersection() {
+  sink = nullptr;
+  list = nullptr;
+  stop_at_first = true;
+  sweep();
+  return witness;
+}
+
+template <typename T, typename EventQueue>
+void sweepline::basic_solver<T, EventQueue>::reset(const std::vector<segment> &line_segments) {
+  // the slab and the window stay where they are in the coordinates of the input
+  // and a window is enlarged by the same margin in the new frame
+  basic_frame<T> fitted = basic_frame<T>::fit(line_segments);
+  if(window) {
+    window = basic_query_window<T>{ fitted.to_local(frame.to_world(window->lo)), fitted.to_local(frame.to_world(window->hi)) };
+    slab_begin = window->lo.x - detail::window_margin<T>, slab_end = window->hi.x + detail::window_margin<T>;
+    clip_lo_y = window->lo.y - detail::window_margin<T>, clip_hi_y = window->hi.y + detail::window_margin<T>;
+  } else {
+    slab_begin = fitted.local_x(frame.world_x(slab_begin)), slab_end = fitted.local_x(frame.world_x(slab_end));
+  }
+  frame = fitted;
+
+  this->line_segments.assign(line_segments, frame);
+
+  sink = nullptr;
+  list = nullptr;
+  counts = { 0, 0 };
+  stop_at_first = false;
+  witness.reset();
+  pending.clear();
+  pending_ids.clear();
+  pending_min_x = std::numeric_limits<T>::infinity();
+  vertical_intersections.clear();
+  vertical_ids.clear();
+  vertical_segs.clear();
+  vert_idx = vert_vert_idx = 0;
+
+  // both are left empty by a complete sweep, but not by one which stopped early or was clipped to a slab
+  event_queue.clear();
+  endpoints.clear();
+  while(!seg_ordering.empty())
+    seg_ordering.erase(seg_ordering.begin());
+}
+
+template <typename T, typename EventQueue>
+void sweepline::basic_solver<T, EventQueue>::sweep() {
   // initialize the sweepline to -inf
-  sweepline::sweeplineX = -std::numeric_limits<geometry::float_t>::max();
+  sweeplineX = -std::numeric_limits<T>::max();
 
   // initialize the event_queue by inserting the end points of the line segments
   // and populate vertical_segs with vertical segments
@@ -225,7 +438,7 @@ std::vector<sweepline::intersection_t> sweepline::solver::solve() {
 
   // sort vertical segments by x then y
   std::sort(vertical_segs.begin(), vertical_segs.end(),
-    [](const geometry::segment_t &a, const geometry::segment_t &b) {
+    [](const segment &a, const segment &b) {
       return a.p.x == b.p.x? a.p.y < b.p.y : a.p.x < b.p.x;
     }
   );
@@ -233,11 +446,20 @@ std::vector<sweepline::intersection_t> sweepline::solver::solve() {
   // find intersections between pairs of vertical line segments
   find_vertical_vertical_intersections();
 
-  while(!event_queue.empty()) {
-    sweepline::event_t top = *event_queue.begin();
-    event_queue.erase(event_queue.begin());
+  // stop as soon as any intersection has been detected, if that is all that is asked for
+  while(has_events() and !witness) {
+    event top = top_event();
+    pop_event();
+
+    // events of segments which stopped being adjacent are left to the events of their new neighbours
+    if(is_stale(top)) {
+      saved.stale_events++;
+      continue;
+    }
 
-    if(top.p.x < sweepline::sweeplineX) {
+    // events past the end of the slab are left to the next slab.
+    // Events within eps in x are ordered by y, so an event may lie just behind the sweepline; it is still processed
+    if(top.p.x < sweeplineX - eps or top.p.x > slab_end + eps) {
       if(verbose)
         detail::debug_continuing();
 
@@ -247,119 +469,227 @@ std::vector<sweepline::intersection_t> sweepline::solver::solve() {
     // find intersections between a vertical line segment and one or more non-vertical segments
     find_vertical_nonvertical_intersections(top.p.x);
 
-    // move sweepline to x coordinate of event being processed
-    sweepline::sweeplineX = top.p.x;
+    // move sweepline to x coordinate of event being processed, never back
+    sweeplineX = std::max(sweeplineX, top.p.x);
+
+    // intersections well behind the sweepline can no longer gain segments
+    flush_intersections(sweeplineX - 2 * eps);
 
     if(verbose)
-      detail::debug_initial(sweepline::sweeplineX, top, event_queue, seg_ordering);
+      detail::debug_initial(sweeplineX, top, remaining_events(), seg_ordering);
 
     // get the active segments with an event at the point currently being processed
     // returns three arrays of active segment indices corresponding to event_t::type
-    auto active_segs = get_active_segs(top);
+    auto &active_segs = get_active_segs(top);
 
     // remove all end points, insert all begin points and reorder the interior points
-    update_segment_ordering(active_segs);
+    update_segment_ordering(top.p, active_segs);
 
     // if no segments were newly inserted, the immediate left and right neighbours
     // of the deleted set of segments become adjacent candidates for intersection
-    if(active_segs[sweepline::event_t::type::begin].size()
-        + active_segs[sweepline::event_t::type::interior].size() == 0)
+    if(active_segs[event::type::begin].size()
+        + active_segs[event::type::interior].size() == 0)
             handle_no_newly_inserted(top.p);
     else
-      handle_extremes_of_newly_inserted();
+      handle_extremes_of_newly_inserted(top.p);
     // else the left and right extremes among the set of newly inserted segments
     // must be checked for intersection with the immediate left and right neighbours respectively
 
-    // reset the sweepline to the x coordinate of event being processed
-    sweepline::sweeplineX = top.p.x;
-
-    // finally report the union of all active segments as an intersection if there are two or more of them
-    if(active_segs[0].size() + active_segs[1].size() + active_segs[2].size() > 1)
-      report_intersection(top.p, std::move(active_segs));
+    // finally report the union of all active segments as an intersection if there are two or more of them,
+    // segments clipped to the beginning of the slab may begin close together without intersecting there,
+    // so intersections on the boundary with the previous slab are left to that slab
+    if(active_segs[0].size() + active_segs[1].size() + active_segs[2].size() > 1
+      and top.p.x > slab_begin + eps)
+      report_intersection(top.p, active_segs);
 
     if(verbose)
-      detail::debug_final(event_queue, seg_ordering);
+      detail::debug_final(remaining_events(), seg_ordering);
   }
 
-  merge_intersection_points();
+  // vertical segments after the last event may still cross segments which run past the end of the slab
+  if(slab_end != std::numeric_limits<T>::max())
+    find_vertical_nonvertical_intersections(slab_end);
+
+  flush_intersections(std::numeric_limits<T>::infinity());
 
   if(verbose)
     std::cerr << std::endl;
-
-  return result;
 }
 
-void sweepline::solver::init_event_queue() {
+template <typename T, typename EventQueue>
+void sweepline::basic_solver<T, EventQueue>::init_event_queue() {
   if(verbose)
     detail::debug_line_segments(line_segments);
 
+  if(line_segments.size() > std::numeric_limits<std::uint32_t>::max())
+    throw std::length_error("too many segments for the ids of sweepline::endpoint_event");
+
+  endpoints.clear();
+  endpoints.reserve(2 * line_segments.size());
+  handles.assign(line_segments.size(), seg_ordering.end());
+  scheduled.assign(line_segments.size(), scheduled_pairs{});
+  compact_at = 2 * line_segments.size() + 64;
+  saved = {};
+
   for(size_t i = 0; i < line_segments.size(); i++) {
-    const auto &p = line_segments[i].p;
-    const auto &q = line_segments[i].q;
+    const point p { line_segments.x1[i], line_segments.y1[i] };
+    const point q { line_segments.x2[i], line_segments.y2[i] };
 
-    if(std::fabs(p.x - q.x) < geometry::EPS) {
+    if(std::fabs(p.x - q.x) < eps) {
       // handle (vertical) segments with same slope as sweepline separately
-      vertical_segs.emplace_back(line_segments[i]);
+      if(slab_begin <= p.x and p.x < slab_end) {
+        segment vseg = line_segments.segment(i);
+        vseg.p.y = std::max(vseg.p.y, clip_lo_y);
+        vseg.q.y = std::min(vseg.q.y, clip_hi_y);
+
+        if(vseg.p.y <= vseg.q.y)
+          vertical_segs.emplace_back(vseg);
+      }
     } else {
-      // insert the begin and end points of each segment in the event queue
-      event_queue.insert({ p, sweepline::event_t::type::begin, i});
-      event_queue.insert({ q, sweepline::event_t::type::end,   i});
+      // the x-range over which the segment lies within the slab, and between clip_lo_y and clip_hi_y
+      T x0 = std::max(p.x, slab_begin), x1 = std::min(q.x, slab_end);
+
+      if(clip_lo_y != -std::numeric_limits<T>::max()
+        or clip_hi_y != std::numeric_limits<T>::max()) {
+
+          if(q.y == p.y) {
+            if(p.y < clip_lo_y or p.y > clip_hi_y)
+              continue;
+          } else {
+            // events within EPS in x are ordered by y, so where a steep segment crosses the top or bottom
+            // it is cut window_margin further out in x, to be inserted before (and removed after) all its points in the window.
+            // Segments through a common point in the margin are cut more than EPS before it, so their order is settled there
+            T x_lo = p.x + (clip_lo_y - p.y) * (q.x - p.x) / (q.y - p.y);
+            T x_hi = p.x + (clip_hi_y - p.y) * (q.x - p.x) / (q.y - p.y);
+            x0 = std::max(x0, std::min(x_lo, x_hi) - detail::window_margin<T>);
+            x1 = std::min(x1, std::max(x_lo, x_hi) + detail::window_margin<T>);
+          }
+      }
+
+      if(x0 > x1)
+        continue;
+
+      // add the begin and end points of each segment to the end points,
+      // segments which start before the slab (or window) begin where they cross into it
+      endpoints.push_back({ radix_key(x0), std::uint32_t(i), event::type::begin });
+
+      // segments which end after the slab are never removed, those which leave the window end where they do
+      if(x1 < slab_end)
+        endpoints.push_back({ radix_key(x1), std::uint32_t(i), event::type::end });
     }
   }
 
+  // sort the end points by x, then those with the same x by y
+  radix_sort(endpoints);
+
+  for(size_t i = 0, j; i < endpoints.size(); i = j) {
+    for(j = i + 1; j < endpoints.size() and endpoints[j].key == endpoints[i].key; j++);
+
+    if(j - i > 1)
+      std::sort(endpoints.begin() + i, endpoints.begin() + j, [this](const endpoint_event &a, const endpoint_event &b) {
+        return endpoint(a) < endpoint(b);
+      });
+  }
+
+  next_endpoint = 0;
+  if(!endpoints.empty())
+    endpoint_head = endpoint(endpoints.front());
+
   if(verbose) {
     detail::debug_vertical_segs(vertical_segs);
     detail::debug_line();
   }
 }
 
-void sweepline::solver::find_vertical_vertical_intersections() {
+template <typename T, typename EventQueue>
+sweepline::basic_event<T> sweepline::basic_solver<T, EventQueue>::endpoint(const endpoint_event &e) const {
+  const auto &segs = line_segments;
+  T x = from_radix_key<T>(e.key);
+
+  // end points clipped to a slab or window lie on the segment where it was cut
+  if(e.tp == event::type::begin)
+    return { x == segs.x1[e.seg_id]? point{ x, segs.y1[e.seg_id] } : point{ x, segs.eval_y(e.seg_id, x) }, e.tp, e.seg_id };
+  return { x == segs.x2[e.seg_id]? point{ x, segs.y2[e.seg_id] } : point{ x, segs.eval_y(e.seg_id, x) }, e.tp, e.seg_id };
+}
+
+template <typename T, typename EventQueue>
+bool sweepline::basic_solver<T, EventQueue>::has_events() const {
+  return next_endpoint < endpoints.size() or !event_queue.empty();
+}
+
+template <typename T, typename EventQueue>
+const sweepline::basic_event<T> &sweepline::basic_solver<T, EventQueue>::top_event() const {
+  if(next_endpoint == endpoints.size() or (!event_queue.empty() and event_queue.top() < endpoint_head))
+    return event_queue.top();
+  return endpoint_head;
+}
+
+template <typename T, typename EventQueue>
+void sweepline::basic_solver<T, EventQueue>::pop_event() {
+  if(next_endpoint == endpoints.size() or (!event_queue.empty() and event_queue.top() < endpoint_head)) {
+    event_queue.pop();
+    return;
+  }
+
+  if(++next_endpoint < endpoints.size())
+    endpoint_head = endpoint(endpoints[next_endpoint]);
+}
+
+template <typename T, typename EventQueue>
+std::vector<sweepline::basic_event<T>> sweepline::basic_solver<T, EventQueue>::remaining_events() const {
+  std::vector<event> events;
+  for(size_t i = next_endpoint; i < endpoints.size(); i++)
+    events.push_back(endpoint(endpoints[i]));
+  event_queue.for_each([&events](const event &e) { events.push_back(e); });
+  return events;
+}
+
+template <typename T, typename EventQueue>
+void sweepline::basic_solver<T, EventQueue>::find_vertical_vertical_intersections() {
   for(size_t i = 0; i + 1 < vertical_segs.size(); i++) {
     if(vertical_segs[i].q == vertical_segs[i + 1].p) {
-      sweepline::intersection_t it {
-        vertical_segs[i].q,
-        std::vector<size_t> {
-          vertical_segs[i].seg_id,
-          vertical_segs[i + 1].seg_id
-        }
-      };
+      detected(vertical_segs[i].q, vertical_segs[i].seg_id, vertical_segs[i + 1].seg_id);
+      vertical_intersections.push_back({ vertical_segs[i].q, vertical_ids.size(), vertical_ids.size() + 2 });
+      vertical_ids.push_back(vertical_segs[i].seg_id);
+      vertical_ids.push_back(vertical_segs[i + 1].seg_id);
 
       if(verbose)
-        detail::debug_intersection(it, "vertical<->vertical segment");
-
-      result.emplace_back(it);
+        detail::debug_intersection(intersection{
+          vertical_segs[i].q, { vertical_segs[i].seg_id, vertical_segs[i + 1].seg_id }
+        }, "vertical<->vertical segment");
     }
   }
 }
 
-void sweepline::solver::find_vertical_nonvertical_intersections(geometry::float_t max_vsegx) {
+template <typename T, typename EventQueue>
+void sweepline::basic_solver<T, EventQueue>::find_vertical_nonvertical_intersections(T max_vsegx) {
   while(vert_idx < vertical_segs.size()
-    and vertical_segs[vert_idx].p.x < sweepline::sweeplineX - geometry::EPS)
+    and vertical_segs[vert_idx].p.x < sweeplineX - eps)
       vert_idx++;
 
   while(vert_idx < vertical_segs.size()
-    and vertical_segs[vert_idx].p.x <= max_vsegx + geometry::EPS) {
+    and vertical_segs[vert_idx].p.x <= max_vsegx + eps) {
 
       auto &vseg = vertical_segs[vert_idx];
-      sweepline::sweeplineX = vseg.p.x;
+      sweeplineX = vseg.p.x;
 
-      auto itr = seg_ordering.lower_bound(geometry::segment_t{ vseg.p, vseg.p, 0 });
+      auto itr = seg_ordering.lower_bound(line_segments.probe(vseg.p));
 
       while(itr != seg_ordering.end()) {
-        geometry::float_t it_y = itr->eval_y(sweepline::sweeplineX);
+        T it_y = line_segments.eval_y(*itr, sweeplineX);
 
-        if(it_y > vseg.q.y + geometry::EPS)
+        if(it_y > vseg.q.y + eps)
           break;
 
-        sweepline::intersection_t it {
-          geometry::point_t{ sweepline::sweeplineX, it_y },
-          std::vector<size_t>{ itr->seg_id, vseg.seg_id }
-        };
+        detected(point{ sweeplineX, it_y }, *itr, vseg.seg_id);
+        pending_ids.push_back(*itr);
+        pending_ids.push_back(vseg.seg_id);
+        add_pending(point{ sweeplineX, it_y }, pending_ids.size() - 2);
 
         if(verbose)
-          detail::debug_intersection(it, "vertical<->non-vertical segment");
-
-        result.emplace_back(it);
+          detail::debug_intersection(intersection{
+            point{ sweeplineX, it_y }, { *itr, vseg.seg_id }
+          }, "vertical<->non-vertical segment");
 
         ++itr;
       }
@@ -368,141 +698,451 @@ void sweepline::solver::find_vertical_nonvertical_intersections(geometry::float_
   }
 }
 
-std::array<std::vector<size_t>, 3> sweepline::solver::get_active_segs(sweepline::event_t top) {
+template <typename T, typename EventQueue>
+std::array<std::vector<size_t>, 3> &sweepline::basic_solver<T, EventQueue>::get_active_segs(event top) {
   // array of all segments with an event at the point currently being processed
   //   active[event_t::type::begin]    -> list of segments which begin at this point
   //   active[event_t::type::interior] -> list of segments which intersect with some other segment at this point
   //   active[event_t::type::end]      -> list of segments which end at this point
-  std::array<std::vector<size_t>, 3> active;
+  // the arrays are reused from one event to the next, so they seldom allocate
+  for(auto &segs: active)
+    segs.clear();
   active[top.tp].push_back(top.seg_id);
 
   // get all segments with an event at top.p and add them to one of the above
-  while(!event_queue.empty() and event_queue.begin()->p == top.p) {
-    sweepline::event_t nxt_top = *event_queue.begin();
-    event_queue.erase(event_queue.begin());
-    active[nxt_top.tp].push_back(nxt_top.seg_id);
+  while(has_events() and top_event().p == top.p) {
+    event nxt_top = top_event();
+    pop_event();
+
+    if(is_stale(nxt_top))
+      saved.stale_events++;
+    else
+      active[nxt_top.tp].push_back(nxt_top.seg_id);
   }
 
+  // unlike a bbst, a heap keeps every copy of an event scheduled more than once, e.g. by both
+  // of the times two segments became adjacent, and an intersection at an end point is scheduled
+  // alongside the end point. Only the first copy is kept, and an interior event of a segment which
+  // begins or ends here is dropped as a bbst would, since it was scheduled last
+  for(auto &segs: active)
+    if(segs.size() > 1) {
+      std::sort(segs.begin(), segs.end());
+      segs.erase(std::unique(segs.begin(), segs.end()), segs.end());
+    }
+
+  auto &interior = active[event::type::interior];
+  if(!interior.empty() and active[event::type::begin].size() + active[event::type::end].size())
+    interior.erase(std::remove_if(interior.begin(), interior.end(), [this](size_t id) {
+      return std::binary_search(active[event::type::begin].begin(), active[event::type::begin].end(), id)
+        or std::binary_search(active[event::type::end].begin(), active[event::type::end].end(), id);
+    }), interior.end());
+
   if(verbose)
     detail::debug_active_events(top, active);
 
   return active;
 }
 
-void sweepline::solver::update_segment_ordering(const std::array<std::vector<size_t>, 3> &active) {
-  // remove all end event segments
-  for(size_t idx: active[sweepline::event_t::type::end])
-    seg_ordering.erase(line_segments[idx]);
+template <typename T, typename EventQueue>
+void sweepline::basic_solver<T, EventQueue>::update_segment_ordering(point cur, std::array<std::vector<size_t>, 3> &active) {
+  // all end and interior event segments pass through cur, the ids of each are sorted by get_active_segs
+  auto &ends = active[event::type::end];
+  auto &interiors = active[event::type::interior];
+  const size_t num_scheduled = interiors.size();
+
+  // look them up by id in the run of segments which meet the sweepline around cur, since
+  // a search by key cannot tell apart segments which meet at the sweepline
+  auto &found = removed_found;
+  found.assign(ends.size() + num_scheduled, false);
+  crossing.clear();
+  bool contiguous = true, gap = false;
+
+  // the run is found from the handle of any of them which still meets the sweepline at cur,
+  // and only by a search by key if there is none, e.g. if only begin events lie at cur
+  auto itr = seg_ordering.end();
+  for(auto *ids: { &ends, &interiors })
+    for(size_t id: *ids)
+      if(itr == seg_ordering.end() and handles[id] != seg_ordering.end()
+        and std::fabs(line_segments.eval_y(id, sweeplineX) - cur.y) <= eps)
+          itr = handles[id];
+
+  // the walk back stops at the first node, before which lies the end, rather than at begin()
+  if(itr == seg_ordering.end())
+    itr = seg_ordering.lower_bound(line_segments.probe({ cur.x, cur.y - eps }));
+  else
+    for(auto prev = std::prev(itr); prev != seg_ordering.end()
+      and line_segments.eval_y(*prev, sweeplineX) >= cur.y - eps; prev = std::prev(itr))
+        itr = prev;
+
+  while(itr != seg_ordering.end() and line_segments.eval_y(*itr, sweeplineX) <= cur.y + 2 * eps) {
+    size_t id = *itr;
+
+    auto end_pos = std::lower_bound(ends.begin(), ends.end(), id);
+    if(end_pos != ends.end() and *end_pos == id) {
+      found[end_pos - ends.begin()] = true;
+      handles[id] = seg_ordering.end();
+      itr = seg_ordering.erase(itr);
+      continue;
+    }
 
-  // remove all interior event segments
-  for(size_t idx: active[sweepline::event_t::type::interior])
-    seg_ordering.erase(line_segments[idx]);
+    auto pos = std::lower_bound(interiors.begin(), interiors.begin() + num_scheduled, id);
+    if(pos != interiors.begin() + num_scheduled and *pos == id)
+      found[ends.size() + (pos - interiors.begin())] = true;
+    else if(point{ sweeplineX, line_segments.eval_y(id, sweeplineX) } == cur)
+      interiors.push_back(id);    // passes through cur, but its event here was never scheduled
+    else {
+      gap = !crossing.empty();
+      ++itr;
+      continue;
+    }
 
-  // increment the sweepline by a very small amount, just past the intersection point
-  sweepline::sweeplineX += geometry::EPS_INC;
+    contiguous = contiguous and !gap;
+    crossing.push_back(itr++);
+  }
 
-  max_y = -std::numeric_limits<geometry::float_t>::max();
-  min_y = std::numeric_limits<geometry::float_t>::max();
+  // segments which strayed from cur are taken out through their handles, which cannot miss as a search by key might,
+  // those with interior events are put back past cur along with the begin segments, in the same node
+  reinserted_ids.clear();
+  extracted.clear();
+  for(size_t i = 0; i < found.size(); i++)
+    if(!found[i]) {
+      size_t id = i < ends.size()? ends[i] : interiors[i - ends.size()];
+      if(handles[id] != seg_ordering.end()) {
+        if(i >= ends.size())
+          extracted.push_back(seg_ordering.extract(handles[id]));
+        else
+          seg_ordering.erase(handles[id]);
+        handles[id] = seg_ordering.end();
+      } else if(i >= ends.size())
+        reinserted_ids.push_back(id);
+    }
 
-  // insert all begin type events
-  for(int idx: active[sweepline::event_t::type::begin]) {
-    min_y = std::min(min_y, line_segments[idx].eval_y(sweepline::sweeplineX));
-    max_y = std::max(max_y, line_segments[idx].eval_y(sweepline::sweeplineX));
-    seg_ordering.insert(line_segments[idx]);
+  // the run is in order past cur once reversed if it was ordered by strictly decreasing slope before it,
+  // otherwise its segments are reinserted one by one
+  bool reversible = contiguous;
+  for(size_t i = 0; reversible and i + 1 < crossing.size(); i++)
+    reversible = line_segments.slopes[*crossing[i]] > line_segments.slopes[*crossing[i + 1]];
+
+  const basic_segment_comparator<T> cmp { &sweeplineX, &line_segments };
+  leftmost = rightmost = line_segments.size();
+
+  if(!crossing.empty()) {
+    if(reversible) {
+      // the nodes stay in place while their segments swap, so the handles follow the segments
+      seg_ordering.reverse(crossing.front(), std::next(crossing.back()));
+      for(auto &it: crossing)
+        handles[*it] = it;
+
+      leftmost = *crossing.front();
+      rightmost = *crossing.back();
+    } else
+      for(auto &it: crossing) {
+        handles[*it] = seg_ordering.end();
+        extracted.push_back(seg_ordering.extract(it));
+      }
   }
 
-  // re-insert all interior type events (so that ordering is updated)
-  for(int idx: active[sweepline::event_t::type::interior]) {
-    min_y = std::min(min_y, line_segments[idx].eval_y(sweepline::sweeplineX));
-    max_y = std::max(max_y, line_segments[idx].eval_y(sweepline::sweeplineX));
-    seg_ordering.insert(line_segments[idx]);
-  }
-}
+  auto track_extremes = [&](std::uint32_t idx) {
+    if(leftmost == line_segments.size() or cmp(idx, leftmost))
+      leftmost = idx;
+    if(rightmost == line_segments.size() or cmp(rightmost, idx))
+      rightmost = idx;
+  };
 
-void sweepline::solver::handle_no_newly_inserted(geometry::point_t cur) {
-  auto b_right = seg_ordering.lower_bound(geometry::segment_t{ cur, cur, 0 });
-  if(b_right != seg_ordering.end() and b_right != seg_ordering.begin()) {
-    auto b_left = b_right;
-    --b_left;
-    if(geometry::is_intersecting(*b_left, *b_right)) {
-      geometry::point_t pt = geometry::intersection_point(*b_left, *b_right);
-      sweepline::event_t::type tp1 = b_left->p == pt? sweepline::event_t::type::begin : sweepline::event_t::type::interior;
-      sweepline::event_t::type tp2 = b_right->p == pt? sweepline::event_t::type::begin : sweepline::event_t::type::interior;
+  // insert all begin type events and re-insert the interior type events which were removed (so that ordering is updated),
+  // the latter through the nodes they were taken out in, so that nothing is allocated
+  for(auto *ids: { &active[event::type::begin], &reinserted_ids })
+    for(size_t idx: *ids) {
+      track_extremes(idx);
 
-      event_queue.insert(sweepline::event_t{ pt, tp1, b_left->seg_id  });
-      event_queue.insert(sweepline::event_t{ pt, tp2, b_right->seg_id });
+      auto [pos, inserted] = seg_ordering.insert(idx);
+      if(inserted)
+        handles[idx] = pos;
     }
+
+  for(auto &nh: extracted) {
+    std::uint32_t idx = nh.value();
+    track_extremes(idx);
+
+    auto result = seg_ordering.insert(std::move(nh));
+    if(result.inserted)
+      handles[idx] = result.position;
   }
+  extracted.clear();
 }
 
-void sweepline::solver::handle_extremes_of_newly_inserted() {
-  geometry::point_t left { sweepline::sweeplineX, min_y - 2 * geometry::EPS }, right { sweepline::sweeplineX, max_y + 2 * geometry::EPS };
-  auto b_right = seg_ordering.lower_bound(geometry::segment_t{ right, right, 0 });
-  auto s_left  = seg_ordering.lower_bound(geometry::segment_t{ left,  left,  0 });
+template <typename T, typename EventQueue>
+void sweepline::basic_solver<T, EventQueue>::find_new_event(std::uint32_t a, std::uint32_t b, point cur) {
+  auto &lo = scheduled[a], &hi = scheduled[b];
 
-  // check for candidate intersection at the right extreme
-  if(b_right != seg_ordering.end() and b_right != seg_ordering.begin()) {
-    auto s_right = b_right;
-    --s_right;
+  // the pair was the last checked for both segments, and its outcome has not changed since
+  if(lo.above == b) {
+    saved.duplicate_pairs++;
+    return;
+  }
 
-    if(is_intersecting(*s_right, *b_right)) {
-      geometry::point_t pt = intersection_point(*s_right, *b_right);
-      sweepline::event_t::type tp1 = s_right->p == pt? sweepline::event_t::type::begin : sweepline::event_t::type::interior;
-      sweepline::event_t::type tp2 = b_right->p == pt? sweepline::event_t::type::begin : sweepline::event_t::type::interior;
+  // the pair was checked just before a segment came in between them and went, so its events are live again,
+  // unless they sort before cur, as a crossing within eps in x of cur may, and were dropped as stale meanwhile
+  point pt = lo.prev_above_pt;
+  bool revived = lo.prev_above == b and hi.prev_below == a
+    and !(event{ pt, event::type::begin, 0 } < event{ cur, event::type::begin, 0 });
+
+  // the pairs each segment was last checked with are no longer adjacent, and become the previous ones
+  const point none { std::numeric_limits<T>::quiet_NaN(), std::numeric_limits<T>::quiet_NaN() };
+  if(lo.above != scheduled_pairs::none and scheduled[lo.above].below == a) {
+    auto &other = scheduled[lo.above];
+    other.prev_below = a, other.prev_below_pt = other.below_pt;
+    other.below = scheduled_pairs::none, other.below_pt = none;
+  }
+  if(hi.below != scheduled_pairs::none and scheduled[hi.below].above == b) {
+    auto &other = scheduled[hi.below];
+    other.prev_above = b, other.prev_above_pt = other.above_pt;
+    other.above = scheduled_pairs::none, other.above_pt = none;
+  }
 
-      event_queue.insert(sweepline::event_t{ pt, tp1, s_right->seg_id });
-      event_queue.insert(sweepline::event_t{ pt, tp2, b_right->seg_id });
-    }
+  if(lo.above != scheduled_pairs::none)
+    lo.prev_above = lo.above, lo.prev_above_pt = lo.above_pt;
+  if(hi.below != scheduled_pairs::none)
+    hi.prev_below = hi.below, hi.prev_below_pt = hi.below_pt;
+  lo.above = b, lo.above_pt = revived? pt : none;
+  hi.below = a, hi.below_pt = revived? pt : none;
+
+  if(revived) {
+    saved.duplicate_pairs++;
+    return;
   }
 
-  // check for candidate intersection at the left extreme
-  if(s_left != seg_ordering.end() and s_left != seg_ordering.begin()) {
-    auto b_left = s_left;
-    --b_left;
+  const segment below = line_segments.segment(a), above = line_segments.segment(b);
+  if(!geometry::is_intersecting(below, above))
+    return;
+
+  pt = geometry::intersection_point(below, above);
+  detected(pt, below.seg_id, above.seg_id);
+
+  // only points past cur are left to process. Events within eps in x are ordered by y, so a crossing just
+  // right of cur may still sort before it, e.g. where a steep segment begins just above its neighbour;
+  // it is processed next if the pair has not crossed yet, i.e. the one below is still the steeper one
+  bool behind = event{ pt, event::type::begin, 0 } < event{ cur, event::type::begin, 0 };
+  if(pt == cur or (behind and !(pt.x >= cur.x - eps and line_segments.slopes[a] > line_segments.slopes[b])))
+    return;
+
+  typename event::type tp1 = below.p == pt? event::type::begin : event::type::interior;
+  typename event::type tp2 = above.p == pt? event::type::begin : event::type::interior;
+
+  // a segment already scheduled at pt with its other neighbour keeps that one event, so the d segments
+  // through a point hold d events between them rather than one for each side of every adjacent pair
+  bool below_has = lo.below_pt.x == pt.x and lo.below_pt.y == pt.y;
+  bool above_has = hi.above_pt.x == pt.x and hi.above_pt.y == pt.y;
+  saved.shared_events += below_has + above_has;
+
+  lo.above_pt = hi.below_pt = pt;
+  if(!below_has)
+    event_queue.push(event{ pt, tp1, below.seg_id });
+  if(!above_has)
+    event_queue.push(event{ pt, tp2, above.seg_id });
+
+  // stale events are dropped as they are popped, and all at once whenever they would outgrow the live ones,
+  // after which the previous pairs can no longer be revived, since their events may be gone
+  if(event_queue.size() > compact_at)
+    compact_event_queue();
+  saved.max_queue_size = std::max(saved.max_queue_size, event_queue.size());
+}
+
+template <typename T, typename EventQueue>
+void sweepline::basic_solver<T, EventQueue>::compact_event_queue() {
+  live_events.clear();
+  event_queue.for_each([this](const event &e) {
+    if(!is_stale(e))
+      live_events.push_back(e);
+  });
+
+  // a pair checked again after its history was lost pushes copies of events which are still queued
+  std::sort(live_events.begin(), live_events.end(), [](const event &a, const event &b) {
+    return std::tie(a.p.x, a.p.y, a.seg_id, a.tp) < std::tie(b.p.x, b.p.y, b.seg_id, b.tp);
+  });
+  live_events.erase(std::unique(live_events.begin(), live_events.end(), [](const event &a, const event &b) {
+    return a.p.x == b.p.x and a.p.y == b.p.y and a.seg_id == b.seg_id and a.tp == b.tp;
+  }), live_events.end());
+
+  saved.stale_events += event_queue.size() - live_events.size();
+  event_queue.clear();
+  for(auto &e: live_events)
+    event_queue.push(e);
+  compact_at = std::max(compact_at, 2 * event_queue.size());
+
+  for(auto &s: scheduled)
+    s.prev_above = s.prev_below = scheduled_pairs::none;
+}
 
-    if(is_intersecting(*b_left, *s_left)) {
-      geometry::point_t pt = intersection_point(*b_left, *s_left);
-      sweepline::event_t::type tp1 = b_left->p == pt? sweepline::event_t::type::begin : sweepline::event_t::type::interior;
-      sweepline::event_t::type tp2 = s_left->p == pt? sweepline::event_t::type::begin : sweepline::event_t::type::interior;
+template <typename T, typename EventQueue>
+bool sweepline::basic_solver<T, EventQueue>::is_stale(const event &e) const {
+  if(e.tp != event::type::interior)
+    return false;
 
-      event_queue.insert(sweepline::event_t{ pt, tp1, b_left->seg_id });
-      event_queue.insert(sweepline::event_t{ pt, tp2, s_left->seg_id });
-    }
+  // the points are compared exactly, since they were computed once and copied into both
+  const auto &s = scheduled[e.seg_id];
+  return !(s.above_pt.x == e.p.x and s.above_pt.y == e.p.y)
+    and !(s.below_pt.x == e.p.x and s.below_pt.y == e.p.y);
+}
+
+template <typename T, typename EventQueue>
+void sweepline::basic_solver<T, EventQueue>::handle_no_newly_inserted(point cur) {
+  auto b_right = seg_ordering.lower_bound(line_segments.probe(cur));
+  if(b_right != seg_ordering.end()) {
+    auto b_left = std::prev(b_right);
+    if(b_left != seg_ordering.end())
+      find_new_event(*b_left, *b_right, cur);
+  }
+}
+
+template <typename T, typename EventQueue>
+void sweepline::basic_solver<T, EventQueue>::handle_extremes_of_newly_inserted(point cur) {
+  // the extremes are found through their handles, and only by a search if they were not inserted
+  auto b_right = handles[rightmost] != seg_ordering.end()? std::next(handles[rightmost])
+                  : seg_ordering.upper_bound(rightmost);
+  auto s_left  = handles[leftmost] != seg_ordering.end()? handles[leftmost]
+                  : seg_ordering.lower_bound(leftmost);
+
+  // check for candidate intersection at the right extreme, the first node has the end before it
+  if(b_right != seg_ordering.end()) {
+    auto s_right = std::prev(b_right);
+    if(s_right != seg_ordering.end())
+      find_new_event(*s_right, *b_right, cur);
+  }
+
+  // check for candidate intersection at the left extreme
+  if(s_left != seg_ordering.end()) {
+    auto b_left = std::prev(s_left);
+    if(b_left != seg_ordering.end())
+      find_new_event(*b_left, *s_left, cur);
   }
 }
 
-void sweepline::solver::report_intersection(geometry::point_t cur, std::array<std::vector<size_t>, 3> &&active) {
-  active[0].insert(active[0].end(), active[1].begin(), active[1].end());
-  active[0].insert(active[0].end(), active[2].begin(), active[2].end());
+template <typename T, typename EventQueue>
+void sweepline::basic_solver<T, EventQueue>::report_intersection(point cur, const std::array<std::vector<size_t>, 3> &active) {
+  size_t first = pending_ids.size();
+  for(auto &segs: active)
+    pending_ids.insert(pending_ids.end(), segs.begin(), segs.end());
 
-  result.emplace_back(sweepline::intersection_t{ cur, std::move(active[0]) });
+  detected(cur, pending_ids[first], pending_ids[first + 1]);
+  add_pending(cur, first);
 
   if(verbose)
-    detail::debug_intersection(result.back());
+    detail::debug_intersection(intersection{
+      cur, std::vector<size_t>(pending_ids.begin() + first, pending_ids.end())
+    });
 }
 
-void sweepline::solver::merge_intersection_points() {
-  std::sort(result.begin(), result.end(),
-    [](const sweepline::intersection_t &a, const sweepline::intersection_t &b) {
-      return a.pt.x == b.pt.x? a.pt.y < b.pt.y : a.pt.x < b.pt.x;
+template <typename T, typename EventQueue>
+void sweepline::basic_solver<T, EventQueue>::flush_intersections(T before) {
+  // vertical<->vertical intersections were all found up front, they join in as the sweepline reaches them
+  for(; vert_vert_idx < vertical_intersections.size()
+    and vertical_intersections[vert_vert_idx].pt.x < before + eps; vert_vert_idx++) {
+
+      auto &it = vertical_intersections[vert_vert_idx];
+      size_t first = pending_ids.size();
+      pending_ids.insert(pending_ids.end(), vertical_ids.begin() + it.first, vertical_ids.begin() + it.last);
+      add_pending(it.pt, first);
+  }
+
+  // nothing to pass on yet, e.g. while many intersections share the x coordinate of the sweepline
+  if(pending.empty() or pending_min_x >= before)
+    return;
+
+  detail::sort_by_point(pending);
+
+  // a point before the limit can only be merged with points already pending
+  size_t i = 0;
+  while(i < pending.size() and pending[i].pt.x < before) {
+    merged_ids.clear();
+
+    size_t j = i;
+    for(; j < pending.size() and pending[j].pt == pending[i].pt; j++)
+      merged_ids.insert(merged_ids.end(), pending_ids.begin() + pending[j].first, pending_ids.begin() + pending[j].last);
+
+    std::sort(merged_ids.begin(), merged_ids.end());
+    merged_ids.erase(std::unique(merged_ids.begin(), merged_ids.end()), merged_ids.end());
+
+    // red ids come first, so a point involves both colours iff its ids fall on either side of num_red
+    bool bichromatic = merged_ids.front() < num_red and merged_ids.back() >= num_red;
+
+    // same-colour crossings are only swept to keep the segment ordering correct,
+    // and crossings in the margin segments are clipped to lie outside the window
+    if((num_red and !bichromatic) or (window and !window->contains(pending[i].pt))) {
+      i = j;
+      continue;
     }
-  );
 
-  std::vector<sweepline::intersection_t> merged;
-  for(size_t i = 0, j; i < result.size(); i = j) {
-    std::vector<size_t> indices;
-    for(j = i; j < result.size() and result[j].pt == result[i].pt; j++)
-      indices.insert(indices.end(), result[j].segments.begin(), result[j].segments.end());
+    if(list)
+      list->push_back(frame.to_world(pending[i].pt), merged_ids.begin(), merged_ids.end());
+    else if(sink)
+      (*sink)(intersection{ frame.to_world(pending[i].pt), merged_ids });
+    else
+      counts.num_points++, counts.num_pairs += merged_ids.size() * (merged_ids.size() - 1) / 2;
 
-    std::sort(indices.begin(), indices.end());
-    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    i = j;
+  }
 
-    merged.emplace_back(
-      sweepline::intersection_t {
-        result[i].pt, indices
-      }
-    );
+  pending.erase(pending.begin(), pending.begin() + i);
+
+  // compact the segments of the intersections still pending
+  merged_ids.clear();
+  pending_min_x = std::numeric_limits<T>::infinity();
+  for(auto &it: pending) {
+    size_t first = merged_ids.size();
+    merged_ids.insert(merged_ids.end(), pending_ids.begin() + it.first, pending_ids.begin() + it.last);
+    it.first = first, it.last = merged_ids.size();
+    pending_min_x = std::min(pending_min_x, it.pt.x);
+  }
+  pending_ids.swap(merged_ids);
+}
+
+template <typename T, typename EventQueue>
+bool sweepline::basic_solver<T, EventQueue>::handles_are_valid() const {
+  // nothing lies before the first node, so a begin() left behind by an insertion would hide the nodes before it
+  if(!seg_ordering.empty() and std::prev(seg_ordering.begin()) != seg_ordering.end())
+    return false;
+
+  size_t num_nodes = 0;
+  for(auto it = seg_ordering.begin(); it != seg_ordering.end(); ++it, num_nodes++)
+    if(*it >= handles.size() or handles[*it] != it)
+      return false;
+
+  // every segment with a handle was reached along the way
+  size_t num_live = std::count_if(handles.begin(), handles.end(), [this](const status_iterator &it) {
+    return it != seg_ordering.end();
+  });
+  return num_nodes == seg_ordering.size() and num_live == num_nodes;
+}
+
+template <typename T, typename EventQueue>
+void sweepline::basic_solver<T, EventQueue>::detected(point pt, size_t a, size_t b) {
+  if(stop_at_first and !witness)
+    witness = intersection{ frame.to_world(pt), { std::min(a, b), std::max(a, b) } };
+}
+
+template <typename T, typename EventQueue>
+void sweepline::basic_solver<T, EventQueue>::add_pending(point pt, size_t first) {
+  pending.push_back({ pt, first, pending_ids.size() });
+  pending_min_x = std::min(pending_min_x, pt.x);
+}
+
+template struct sweepline::basic_segment_comparator<float>;
+template struct sweepline::basic_segment_comparator<double>;
+template class sweepline::basic_solver<float>;
+template class sweepline::basic_solver<double>;
+template class sweepline::basic_solver<double, sweepline::bbst_event_queue<sweepline::basic_event<double>>>;
+template class sweepline::basic_solver<double, sweepline::heap_event_queue<sweepline::basic_event<double>, 2>>;
+template class sweepline::basic_solver<double, sweepline::radix_event_queue<sweepline::basic_event<double>>>;
+
+void sweepline::merge_intersection_points(std::vector<sweepline::intersection_t> &result) {
+  detail::sort_by_point(result);
+
+  std::vector<sweepline::intersection_t> merged;
+  for(size_t i = 0; i < result.size(); ) {
+    merged.emplace_back();
+    i = detail::merge_run(result, i, merged.back());
   }
 
   result = std::move(merged);
-}
\ No newline at end of file
+}
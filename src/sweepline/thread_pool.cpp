@@ -0,0 +1,122 @@
+#include <thread_pool.hpp>
+#include <algorithm>
+
+sweepline::thread_pool::thread_pool(size_t num_threads) {
+  if(num_threads == 0)
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+  for(size_t i = 0; i < num_threads; i++)
+    ranges.emplace_back(std::make_unique<task_range>());
+
+  for(size_t i = 0; i < num_threads; i++)
+    workers.emplace_back(&thread_pool::worker_loop, this, i);
+}
+
+sweepline::thread_pool::~thread_pool() {
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    stopping = true;
+  }
+  work_cv.notify_all();
+
+  for(auto &worker: workers)
+    worker.join();
+}
+
+void sweepline::thread_pool::run(size_t num_tasks, const std::function<void(size_t)> &task) {
+  run(num_tasks, [&task](size_t idx, size_t) { task(idx); });
+}
+
+void sweepline::thread_pool::run(size_t num_tasks, const std::function<void(size_t, size_t)> &task) {
+  if(num_tasks == 0)
+    return;
+
+  std::unique_lock<std::mutex> lock(mtx);
+
+  // deal out contiguous ranges, the workers are all idle so nobody else touches them
+  for(size_t i = 0; i < workers.size(); i++) {
+    ranges[i]->begin = num_tasks * i / workers.size();
+    ranges[i]->end = num_tasks * (i + 1) / workers.size();
+  }
+
+  this->task = &task;
+  num_busy = workers.size();
+  error = nullptr;
+  batch++;
+  work_cv.notify_all();
+
+  // a worker only goes idle once no tasks are left anywhere, so the batch is over when all of them are
+  done_cv.wait(lock, [this] { return num_busy == 0; });
+  this->task = nullptr;
+
+  if(error)
+    std::rethrow_exception(error);
+}
+
+bool sweepline::thread_pool::next_task(size_t worker, size_t &idx) {
+  auto &own = *ranges[worker];
+
+  {
+    std::lock_guard<std::mutex> lock(own.mtx);
+    if(own.begin < own.end) {
+      idx = own.begin++;
+      return true;
+    }
+  }
+
+  // steal the back half of the first non-empty range after our own
+  for(size_t d = 1; d < ranges.size(); d++) {
+    auto &victim = *ranges[(worker + d) % ranges.size()];
+    size_t begin, end;
+
+    {
+      std::lock_guard<std::mutex> lock(victim.mtx);
+      if(victim.begin == victim.end)
+        continue;
+
+      begin = victim.begin + (victim.end - victim.begin) / 2;
+      end = victim.end;
+      victim.end = begin;
+    }
+
+    std::lock_guard<std::mutex> lock(own.mtx);
+    own.begin = begin + 1;
+    own.end = end;
+    idx = begin;
+    return true;
+  }
+
+  return false;
+}
+
+void sweepline::thread_pool::worker_loop(size_t worker) {
+  size_t seen_batch = 0;
+  std::unique_lock<std::mutex> lock(mtx);
+
+  while(true) {
+    work_cv.wait(lock, [&] { return stopping or batch != seen_batch; });
+    if(stopping)
+      return;
+
+    seen_batch = batch;
+    auto &cur_task = *task;
+
+    lock.unlock();
+    std::exception_ptr cur_error;
+    for(size_t idx; next_task(worker, idx); ) {
+      try {
+        cur_task(idx, worker);
+      } catch(...) {
+        if(!cur_error)
+          cur_error = std::current_exception();
+      }
+    }
+    lock.lock();
+
+    if(cur_error and !error)
+      error = cur_error;
+
+    if(--num_busy == 0)
+      done_cv.notify_all();
+  }
+}
@@ -65,20 +65,28 @@ utils::args utils::parse_args_and_redirect_streams(int argc, char *argv[]) {
       .implicit_value(true)
       .help("disable color printing");
 
+    program.add_argument("-j", "--threads")
+      .default_value(size_t(1))
+      .scan<'u', size_t>()
+      .help("number of threads to sweep with, 0 picks one per hardware thread");
+
     try {
         program.parse_args(argc, argv);
         if(program.get<bool>("--verbose") == false and program.present("--logf"))
             throw std::runtime_error("--verbose must be set to true");
+        if(program.get<bool>("--verbose") == true and program.get<size_t>("--threads") != 1)
+            throw std::runtime_error("--verbose cannot be used with --threads");
     } catch (const std::runtime_error& err) {
         std::cerr << err.what() << std::endl;
         std::cerr << program;
         std::exit(1);
     }
 
-    args params = { "", "", "", false, true };
+    args params = { "", "", "", false, true, 1 };
 
     params.enable_color = !program.get<bool>("--nocolor");
     params.verbose = program.get<bool>("--verbose");
+    params.num_threads = program.get<size_t>("--threads");
     if(params.verbose)
         std::cout << "Running in verbose mode" << std::endl;
 
@@ -1,6 +1,18 @@
 #include <benchmark/benchmark.h>
+#include <dynamic_index.hpp>
+#include <exact_solver.hpp>
 #include <generators.hpp>
+#include <memory_tracker.hpp>
 #include <sweepline.hpp>
+#include <thread_pool.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <type_traits>
 
 /*
 static void CustomArguments(benchmark::internal::Benchmark* b) {
@@ -13,6 +25,25 @@ static void CustomArguments(benchmark::internal::Benchmark* b) {
 }
 */
 
+// counts the comparisons (if built with SWEEPLINE_STATS), allocations, peak memory and events saved by one more sweep of the segments, outside of the timed loop
+static void add_status_counters(benchmark::State& state, const std::vector<geometry::segment_t> &segments) {
+    size_t base = memory_tracker::current_bytes(), allocations = memory_tracker::allocations();
+    memory_tracker::reset_peak();
+
+    sweepline::solver solver(segments, false, false);
+    benchmark::DoNotOptimize(solver.count());
+
+#ifdef SWEEPLINE_STATS
+    state.counters["comparisons"] = solver.num_comparisons();
+#endif
+    state.counters["allocations"] = memory_tracker::allocations() - allocations;
+    state.counters["peak_bytes"] = memory_tracker::peak_bytes() - base;
+    state.counters["duplicate_pairs"] = solver.event_counts().duplicate_pairs;
+    state.counters["stale_events"] = solver.event_counts().stale_events;
+    state.counters["shared_events"] = solver.event_counts().shared_events;
+    state.counters["max_queue_size"] = solver.event_counts().max_queue_size;
+}
+
 static void BM_ObliqueGrid(benchmark::State& state) {
     int horiz = state.range(0);
     int verti = state.range(1);
@@ -33,6 +64,7 @@ static void BM_ObliqueGrid(benchmark::State& state) {
 
     state.counters["num_segments"] = n;
     state.counters["num_intersections"] = m;
+    state.SetItemsProcessed(state.iterations() * m);
     state.SetComplexityN(n + m);
 }
 
@@ -47,6 +79,266 @@ BENCHMARK(BM_ObliqueGrid)
     ->Complexity(benchmark::oNLogN);
 
 
+template <typename Result>
+static Result find_all(const std::vector<geometry::segment_t> &segments) {
+    if constexpr(std::is_same_v<Result, sweepline::intersection_list>)
+        return sweepline::find_intersection_list(segments);
+    else
+        return sweepline::find_intersections(segments);
+}
+
+// the oblique grid, with its result held as a vector of intersections or as a flat list
+template <typename Result>
+static void BM_ObliqueGridResult(benchmark::State& state) {
+    int horiz = state.range(0);
+    int verti = state.range(1);
+    int n = horiz + verti;
+    int m = horiz * verti;
+
+    std::vector<geometry::segment_t> segments = generators::gen_oblique_grid(horiz, verti);
+
+    // the bytes the result holds on to after the solver is gone, and the allocations made for it
+    size_t base = memory_tracker::current_bytes(), allocations = memory_tracker::allocations();
+    size_t result_bytes;
+    {
+        Result result = find_all<Result>(segments);
+        result_bytes = memory_tracker::current_bytes() - base;
+        allocations = memory_tracker::allocations() - allocations;
+    }
+
+    for(auto _ : state) {
+        Result result = find_all<Result>(segments);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.counters["num_segments"] = n;
+    state.counters["num_intersections"] = m;
+    state.counters["bytes_per_intersection"] = double(result_bytes) / m;
+    state.counters["allocations"] = allocations;
+    state.SetItemsProcessed(state.iterations() * m);
+    state.SetComplexityN(n + m);
+}
+
+BENCHMARK_TEMPLATE(BM_ObliqueGridResult, std::vector<sweepline::intersection_t>)
+    ->ArgsProduct({
+        { 1 << 7, 1 << 9 },
+        { 1 << 6, 1 << 8 }
+    });
+
+BENCHMARK_TEMPLATE(BM_ObliqueGridResult, sweepline::intersection_list)
+    ->ArgsProduct({
+        { 1 << 7, 1 << 9 },
+        { 1 << 6, 1 << 8 }
+    });
+
+
+static void BM_ObliqueGridCount(benchmark::State& state) {
+    int horiz = state.range(0);
+    int verti = state.range(1);
+    int n = horiz + verti;
+    int m = horiz * verti;
+
+    for(auto _ : state) {
+        state.PauseTiming();
+
+        std::vector<geometry::segment_t> segments = generators::gen_oblique_grid(horiz, verti);
+
+        state.ResumeTiming();
+
+        sweepline::intersection_count result = sweepline::count_intersections(segments);
+        benchmark::DoNotOptimize(result);
+    }
+
+    add_status_counters(state, generators::gen_oblique_grid(horiz, verti));
+    state.counters["num_segments"] = n;
+    state.counters["num_intersections"] = m;
+    state.SetItemsProcessed(state.iterations() * m);
+    state.SetComplexityN(n + m);
+}
+
+// same arguments as BM_ObliqueGrid, for comparing counting with reporting
+BENCHMARK(BM_ObliqueGridCount)
+    ->ArgsProduct({
+        { 1 << 5, 1 << 7, 1 << 9 },
+        { 1 << 4, 1 << 6, 1 << 8 }
+    })
+    ->Complexity(benchmark::oNLogN);
+
+
+// the oblique grid rounded to integers, swept with tolerances
+static void BM_ObliqueGridRounded(benchmark::State& state) {
+    int horiz = state.range(0);
+    int verti = state.range(1);
+    int n = horiz + verti;
+    int m = horiz * verti;
+
+    std::vector<geometry::segment_t> segments =
+        generators::to_float(generators::to_integer(generators::gen_oblique_grid(horiz, verti)));
+
+    for(auto _ : state) {
+        std::vector<sweepline::intersection_t> result = sweepline::find_intersections(segments);
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.counters["num_segments"] = n;
+    state.counters["num_intersections"] = m;
+    state.SetItemsProcessed(state.iterations() * m);
+    state.SetComplexityN(n + m);
+}
+
+// same arguments as BM_ObliqueGrid
+BENCHMARK(BM_ObliqueGridRounded)
+    ->ArgsProduct({
+        { 1 << 5, 1 << 7, 1 << 9 },
+        { 1 << 4, 1 << 6, 1 << 8 }
+    })
+    ->Complexity(benchmark::oNLogN);
+
+
+// the same rounded grid, swept exactly
+static void BM_ObliqueGridExact(benchmark::State& state) {
+    int horiz = state.range(0);
+    int verti = state.range(1);
+    int n = horiz + verti;
+    int m = horiz * verti;
+
+    std::vector<geometry::isegment_t<std::int64_t>> segments =
+        generators::to_integer(generators::gen_oblique_grid(horiz, verti));
+
+    for(auto _ : state) {
+        std::vector<sweepline::exact_intersection_t> result = sweepline::find_intersections(segments);
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.counters["num_segments"] = n;
+    state.counters["num_intersections"] = m;
+    state.SetItemsProcessed(state.iterations() * m);
+    state.SetComplexityN(n + m);
+}
+
+// same arguments as BM_ObliqueGrid
+BENCHMARK(BM_ObliqueGridExact)
+    ->ArgsProduct({
+        { 1 << 5, 1 << 7, 1 << 9 },
+        { 1 << 4, 1 << 6, 1 << 8 }
+    })
+    ->Complexity(benchmark::oNLogN);
+
+
+// the segments in scalar type T, floats only represent coordinates of magnitude about 1 well enough for their tolerance
+template <typename T>
+static std::vector<geometry::basic_segment<T>> in_scalar_type(const std::vector<geometry::segment_t> &segments) {
+    if constexpr(std::is_same_v<T, float>)
+        return generators::to_single_precision(segments);
+    else
+        return segments;
+}
+
+// the oblique grid scaled to the square [-1, 1] x [-1, 1], swept in scalar type T
+template <typename T>
+static void BM_ObliqueGridScalar(benchmark::State& state) {
+    int horiz = state.range(0);
+    int verti = state.range(1);
+    int n = horiz + verti;
+    int m = horiz * verti;
+
+    std::vector<geometry::basic_segment<T>> segments =
+        in_scalar_type<T>(generators::scale(generators::gen_oblique_grid(horiz, verti), 1e-6));
+
+    // the peak of a single sweep, since the BBSTs keep the nodes they allocate
+    size_t base = memory_tracker::current_bytes();
+    memory_tracker::reset_peak();
+    benchmark::DoNotOptimize(sweepline::find_intersections(segments).data());
+    size_t peak_bytes = memory_tracker::peak_bytes() - base;
+
+    for(auto _ : state) {
+        std::vector<sweepline::basic_intersection<T>> result = sweepline::find_intersections(segments);
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.counters["num_segments"] = n;
+    state.counters["num_intersections"] = m;
+    state.counters["peak_bytes"] = peak_bytes;
+    state.SetItemsProcessed(state.iterations() * m);
+    state.SetComplexityN(n + m);
+}
+
+BENCHMARK_TEMPLATE(BM_ObliqueGridScalar, float)
+    ->ArgsProduct({
+        { 1 << 7, 1 << 9 },
+        { 1 << 6, 1 << 8 }
+    })
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK_TEMPLATE(BM_ObliqueGridScalar, double)
+    ->ArgsProduct({
+        { 1 << 7, 1 << 9 },
+        { 1 << 6, 1 << 8 }
+    })
+    ->Complexity(benchmark::oNLogN);
+
+
+// the events of the solver kept in each of the event queues, same arguments as BM_ObliqueGridCount
+template <typename EventQueue>
+static void BM_ObliqueGridQueue(benchmark::State& state) {
+    int horiz = state.range(0);
+    int verti = state.range(1);
+    int n = horiz + verti;
+    int m = horiz * verti;
+
+    std::vector<geometry::segment_t> segments = generators::gen_oblique_grid(horiz, verti);
+
+    for(auto _ : state) {
+        sweepline::intersection_count counts = sweepline::basic_solver<double, EventQueue>(segments, false, false).count();
+        benchmark::DoNotOptimize(counts);
+    }
+
+    state.counters["num_segments"] = n;
+    state.counters["num_intersections"] = m;
+    state.SetItemsProcessed(state.iterations() * m);
+    state.SetComplexityN(n + m);
+}
+
+BENCHMARK_TEMPLATE(BM_ObliqueGridQueue, sweepline::bbst_event_queue<sweepline::event_t>)
+    ->ArgsProduct({ { 1 << 7, 1 << 9 }, { 1 << 6, 1 << 8 } });
+BENCHMARK_TEMPLATE(BM_ObliqueGridQueue, sweepline::heap_event_queue<sweepline::event_t, 2>)
+    ->ArgsProduct({ { 1 << 7, 1 << 9 }, { 1 << 6, 1 << 8 } });
+BENCHMARK_TEMPLATE(BM_ObliqueGridQueue, sweepline::heap_event_queue<sweepline::event_t, 4>)
+    ->ArgsProduct({ { 1 << 7, 1 << 9 }, { 1 << 6, 1 << 8 } });
+BENCHMARK_TEMPLATE(BM_ObliqueGridQueue, sweepline::radix_event_queue<sweepline::event_t>)
+    ->ArgsProduct({ { 1 << 7, 1 << 9 }, { 1 << 6, 1 << 8 } });
+
+
+// the events of the solver kept in each of the event queues, few intersections and mostly end point events
+template <typename EventQueue>
+static void BM_RandomSegmentsQueue(benchmark::State& state) {
+    int n = state.range(0);
+    size_t m = 0;
+
+    std::vector<geometry::segment_t> segments = generators::gen_random_segments(n);
+
+    for(auto _ : state) {
+        sweepline::intersection_count counts = sweepline::basic_solver<double, EventQueue>(segments, false, false).count();
+        benchmark::DoNotOptimize(counts);
+        m = counts.num_points;
+    }
+
+    state.counters["num_segments"] = n;
+    state.counters["num_intersections"] = m;
+    state.SetComplexityN(n + m);
+}
+
+BENCHMARK_TEMPLATE(BM_RandomSegmentsQueue, sweepline::bbst_event_queue<sweepline::event_t>)
+    ->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_RandomSegmentsQueue, sweepline::heap_event_queue<sweepline::event_t, 2>)
+    ->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_RandomSegmentsQueue, sweepline::heap_event_queue<sweepline::event_t, 4>)
+    ->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_RandomSegmentsQueue, sweepline::radix_event_queue<sweepline::event_t>)
+    ->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+
+
 static void BM_OriginStar(benchmark::State& state) {
     int n = state.range(0);
     int m = 1;
@@ -63,6 +355,7 @@ static void BM_OriginStar(benchmark::State& state) {
         benchmark::DoNotOptimize(result.data());
     }
 
+    add_status_counters(state, generators::gen_origin_star(n));
     state.counters["num_segments"] = n;
     state.counters["num_intersections"] = m;
     state.SetComplexityN(n + m);
@@ -73,9 +366,587 @@ BENCHMARK(BM_OriginStar)
     ->DenseRange(3, 10000, 2000)
     ->Complexity(benchmark::oNLogN);
 
+
+static void BM_RandomSegments(benchmark::State& state) {
+    int n = state.range(0);
+    size_t m = 0;
+
+    for(auto _ : state) {
+        state.PauseTiming();
+
+        std::vector<geometry::segment_t> segments = generators::gen_random_segments(n);
+
+        state.ResumeTiming();
+
+        std::vector<sweepline::intersection_t> result = sweepline::find_intersections(segments);
+        benchmark::DoNotOptimize(result.data());
+        m = result.size();
+    }
+
+    add_status_counters(state, generators::gen_random_segments(n));
+    state.counters["num_segments"] = n;
+    state.counters["num_intersections"] = m;
+    state.SetComplexityN(n + m);
+}
+
+BENCHMARK(BM_RandomSegments)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 16)
+    ->Complexity(benchmark::oNLogN);
+
+
+// segments spanning the whole range, so that pairs keep becoming adjacent again as the segments between them cross
+static void BM_LongSegments(benchmark::State& state) {
+    int n = state.range(0);
+    size_t m = 0;
+
+    for(auto _ : state) {
+        state.PauseTiming();
+
+        std::vector<geometry::segment_t> segments = generators::gen_long_segments(n);
+
+        state.ResumeTiming();
+
+        sweepline::intersection_count result = sweepline::count_intersections(segments);
+        benchmark::DoNotOptimize(result);
+        m = result.num_pairs;
+    }
+
+    add_status_counters(state, generators::gen_long_segments(n));
+    state.counters["num_segments"] = n;
+    state.counters["num_intersections"] = m;
+    state.SetComplexityN(n + m);
+}
+
+BENCHMARK(BM_LongSegments)
+    ->RangeMultiplier(2)->Range(1 << 8, 1 << 11)
+    ->Complexity(benchmark::oNLogN);
+
+
+static void BM_ObliqueGridParallel(benchmark::State& state) {
+    int horiz = state.range(0);
+    int verti = state.range(1);
+    size_t num_threads = state.range(2);
+    int n = horiz + verti;
+    int m = horiz * verti;
+
+    for(auto _ : state) {
+        state.PauseTiming();
+
+        std::vector<geometry::segment_t> segments = generators::gen_oblique_grid(horiz, verti);
+
+        state.ResumeTiming();
+
+        std::vector<sweepline::intersection_t> result = sweepline::find_intersections_parallel(segments, num_threads);
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.counters["num_segments"] = n;
+    state.counters["num_intersections"] = m;
+    state.counters["num_threads"] = num_threads;
+}
+
+// Args[0] = horizontal cnt
+// Args[1] = vertical cnt
+// Args[2] = number of threads
+BENCHMARK(BM_ObliqueGridParallel)
+    ->ArgsProduct({
+        { 1 << 9 },
+        { 1 << 8 },
+        { 1, 2, 4, 8, 16, 32 }
+    })
+    ->UseRealTime();
+
+
+static void BM_RandomSegmentsParallel(benchmark::State& state) {
+    int n = state.range(0);
+    size_t num_threads = state.range(1);
+    size_t m = 0;
+
+    for(auto _ : state) {
+        state.PauseTiming();
+
+        std::vector<geometry::segment_t> segments = generators::gen_random_segments(n);
+
+        state.ResumeTiming();
+
+        std::vector<sweepline::intersection_t> result = sweepline::find_intersections_parallel(segments, num_threads);
+        benchmark::DoNotOptimize(result.data());
+        m = result.size();
+    }
+
+    state.counters["num_segments"] = n;
+    state.counters["num_intersections"] = m;
+    state.counters["num_threads"] = num_threads;
+}
+
+// Args[0] = number of segments
+// Args[1] = number of threads
+BENCHMARK(BM_RandomSegmentsParallel)
+    ->ArgsProduct({
+        { 1 << 16 },
+        { 1, 2, 4, 8, 16, 32 }
+    })
+    ->UseRealTime();
+
+static void BM_AnyIntersectionGrid(benchmark::State& state) {
+    int horiz = state.range(0);
+    int verti = state.range(0);
+    int n = horiz + verti;
+
+    for(auto _ : state) {
+        state.PauseTiming();
+
+        std::vector<geometry::segment_t> segments = generators::gen_oblique_grid(horiz, verti);
+
+        state.ResumeTiming();
+
+        std::optional<sweepline::intersection_t> result = sweepline::any_intersection(segments);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.counters["num_segments"] = n;
+    state.counters["num_intersections"] = horiz * verti;
+    state.SetComplexityN(n);
+}
+
+// Args[0] = horizontal cnt = vertical cnt
+BENCHMARK(BM_AnyIntersectionGrid)
+    ->RangeMultiplier(4)
+    ->Range(1 << 5, 1 << 11)
+    ->Complexity(benchmark::oNLogN);
+
+
+static void BM_AnyIntersectionStar(benchmark::State& state) {
+    int n = state.range(0);
+
+    for(auto _ : state) {
+        state.PauseTiming();
+
+        std::vector<geometry::segment_t> segments = generators::gen_origin_star(n);
+
+        state.ResumeTiming();
+
+        std::optional<sweepline::intersection_t> result = sweepline::any_intersection(segments);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.counters["num_segments"] = n;
+    state.counters["num_intersections"] = 1;
+    state.SetComplexityN(n);
+}
+
+BENCHMARK(BM_AnyIntersectionStar)
+    ->DenseRange(3, 10000, 2000)
+    ->Complexity(benchmark::oNLogN);
+
+
+// stops at the first intersection, close to the beginning of the sweep, so it mostly measures the
+// time and memory taken to set the sweep up, i.e. to build the event queue and sort the end points
+static void BM_AnyIntersectionRandom(benchmark::State& state) {
+    int n = state.range(0);
+
+    std::vector<geometry::segment_t> segments = generators::gen_random_segments(n);
+
+    // the peak of a single sweep, since the BBSTs keep the nodes they allocate
+    size_t base = memory_tracker::current_bytes();
+    memory_tracker::reset_peak();
+    benchmark::DoNotOptimize(sweepline::any_intersection(segments));
+    size_t peak_bytes = memory_tracker::peak_bytes() - base;
+
+    for(auto _ : state) {
+        std::optional<sweepline::intersection_t> result = sweepline::any_intersection(segments);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.counters["num_segments"] = n;
+    state.counters["peak_bytes"] = peak_bytes;
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetComplexityN(n);
+}
+
+BENCHMARK(BM_AnyIntersectionRandom)
+    ->RangeMultiplier(4)
+    ->Range(1 << 14, 1 << 20)
+    ->Complexity(benchmark::oNLogN);
+
+
+// a dense grid of red segments crossed by a few short blue segments near its middle,
+// so almost all crossings are red<->red
+static void BM_RedBlue(benchmark::State& state) {
+    int horiz = state.range(0);
+    int verti = state.range(0);
+    int num_blue = state.range(1);
+    size_t m = 0;
+
+    for(auto _ : state) {
+        state.PauseTiming();
+
+        std::vector<geometry::segment_t> red = generators::gen_oblique_grid(horiz, verti);
+        std::vector<geometry::segment_t> blue = generators::gen_random_segments(num_blue);
+
+        state.ResumeTiming();
+
+        std::vector<sweepline::intersection_t> result = sweepline::find_red_blue_intersections(red, blue);
+        benchmark::DoNotOptimize(result.data());
+        m = result.size();
+    }
+
+    state.counters["num_segments"] = horiz + verti + num_blue;
+    state.counters["num_intersections"] = m;
+}
+
+// Args[0] = horizontal cnt = vertical cnt of the red grid
+// Args[1] = number of blue segments
+BENCHMARK(BM_RedBlue)
+    ->ArgsProduct({
+        { 1 << 7, 1 << 9 },
+        { 1 << 10 }
+    });
+
+
+// the same input as BM_RedBlue, with every intersection found and the red<->blue ones picked out afterwards
+static void BM_RedBlueFiltered(benchmark::State& state) {
+    int horiz = state.range(0);
+    int verti = state.range(0);
+    int num_blue = state.range(1);
+    size_t m = 0;
+
+    for(auto _ : state) {
+        state.PauseTiming();
+
+        std::vector<geometry::segment_t> segments = generators::gen_oblique_grid(horiz, verti);
+        size_t num_red = segments.size();
+        for(auto seg: generators::gen_random_segments(num_blue)) {
+            seg.seg_id += num_red;
+            segments.push_back(seg);
+        }
+
+        state.ResumeTiming();
+
+        std::vector<sweepline::intersection_t> result = sweepline::find_intersections(segments);
+        result.erase(std::remove_if(result.begin(), result.end(),
+            [num_red](const sweepline::intersection_t &it) {
+                return it.segments.front() >= num_red or it.segments.back() < num_red;
+            }), result.end());
+        benchmark::DoNotOptimize(result.data());
+        m = result.size();
+    }
+
+    state.counters["num_segments"] = horiz + verti + num_blue;
+    state.counters["num_intersections"] = m;
+}
+
+// same arguments as BM_RedBlue
+BENCHMARK(BM_RedBlueFiltered)
+    ->ArgsProduct({
+        { 1 << 7, 1 << 9 },
+        { 1 << 10 }
+    });
+
+
+// a square window in the middle of the random segments, to compare with BM_RandomSegments over the same input
+static void BM_QueryWindow(benchmark::State& state) {
+    int n = state.range(0);
+    geometry::float_t side = 2e4 / state.range(1);
+    size_t m = 0;
+
+    std::vector<geometry::segment_t> segments = generators::gen_random_segments(n);
+    sweepline::query_window window { { -side / 2, -side / 2 }, { side / 2, side / 2 } };
+
+    for(auto _ : state) {
+        std::vector<sweepline::intersection_t> result = sweepline::find_intersections(segments, window);
+        benchmark::DoNotOptimize(result.data());
+        m = result.size();
+    }
+
+    state.counters["num_segments"] = n;
+    state.counters["num_intersections"] = m;
+}
+
+// Args[0] = number of segments
+// Args[1] = how many times smaller the side of the window is than the side of the input
+BENCHMARK(BM_QueryWindow)
+    ->ArgsProduct({
+        { 1 << 16 },
+        { 1, 4, 16, 64 }
+    });
+
+
+// the sizes of the tiles BM_TilesLoop and BM_TilesBatch are run on: number of tiles, least and most segments in a tile.
+// The sweep itself dominates on tiles of hundreds of segments, and setting up a solver on tiles of a few
+static const std::vector<std::vector<std::int64_t>> tile_sizes {
+    { 1 << 12, 10, 500 },
+    { 1 << 14, 4, 32 },
+    { 1 << 16, 2, 8 }
+};
+
+// many small independent instances, solved one after another
+static void BM_TilesLoop(benchmark::State& state) {
+    int num_tiles = state.range(0);
+    std::vector<std::vector<geometry::segment_t>> tiles = generators::gen_tiles(num_tiles, state.range(1), state.range(2));
+
+    for(auto _ : state) {
+        for(auto &tile: tiles) {
+            std::vector<sweepline::intersection_t> result = sweepline::find_intersections(tile);
+            benchmark::DoNotOptimize(result.data());
+        }
+    }
+
+    state.counters["num_tiles"] = num_tiles;
+    state.SetItemsProcessed(state.iterations() * num_tiles);
+}
+
+static void TilesLoopArguments(benchmark::internal::Benchmark* b) {
+    for(auto &sizes: tile_sizes)
+        b->Args(sizes);
+}
+
+// Args[0] = number of tiles
+// Args[1] = least number of segments in a tile
+// Args[2] = most number of segments in a tile
+BENCHMARK(BM_TilesLoop)
+    ->Apply(TilesLoopArguments)
+    ->UseRealTime();
+
+
+// the same instances as BM_TilesLoop, solved by find_intersections_batch() on a pool kept across iterations
+static void BM_TilesBatch(benchmark::State& state) {
+    int num_tiles = state.range(0);
+    size_t num_threads = state.range(3);
+    std::vector<std::vector<geometry::segment_t>> tiles = generators::gen_tiles(num_tiles, state.range(1), state.range(2));
+    sweepline::thread_pool pool(num_threads);
+
+    for(auto _ : state) {
+        std::vector<std::vector<sweepline::intersection_t>> result = sweepline::find_intersections_batch(tiles, pool);
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.counters["num_tiles"] = num_tiles;
+    state.counters["num_threads"] = num_threads;
+    state.SetItemsProcessed(state.iterations() * num_tiles);
+}
+
+static void TilesBatchArguments(benchmark::internal::Benchmark* b) {
+    for(auto sizes: tile_sizes)
+        for(std::int64_t num_threads: { 1, 2, 4, 8, 16, 32 }) {
+            sizes.push_back(num_threads);
+            b->Args(sizes);
+            sizes.pop_back();
+        }
+}
+
+// Args[0..2] = as for BM_TilesLoop
+// Args[3] = number of threads
+BENCHMARK(BM_TilesBatch)
+    ->Apply(TilesBatchArguments)
+    ->UseRealTime();
+
+
+// one segment inserted into and erased from an index of n random segments,
+// to compare with rerunning BM_RandomSegments after every edit
+static void BM_DynamicIndexEdit(benchmark::State& state) {
+    int n = state.range(0);
+    std::vector<geometry::segment_t> segments = generators::gen_random_segments(n);
+    std::vector<geometry::segment_t> edits = generators::gen_random_segments(1 << 10, 2);
+    sweepline::dynamic_index index(segments);
+    size_t i = 0;
+
+    for(auto _ : state) {
+        geometry::segment_t seg = edits[i++ % edits.size()];
+        seg.seg_id = n;
+
+        std::vector<sweepline::intersection_t> gained = index.insert(seg);
+        std::vector<sweepline::intersection_t> lost = index.erase(seg.seg_id);
+        benchmark::DoNotOptimize(gained.data());
+        benchmark::DoNotOptimize(lost.data());
+    }
+
+    state.counters["num_segments"] = n;
+    state.SetComplexityN(n);
+}
+
+BENCHMARK(BM_DynamicIndexEdit)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 16)
+    ->Complexity(benchmark::o1);
+
+
+// a tree of n keys with one erased and another inserted in its place, as the status churns during a sweep,
+// with its nodes allocated from the heap or recycled through the pool, and keeping subtree sizes or not
+template <typename Allocator, typename NodeUpdate = BBST::null_node_update>
+static void BM_TreeChurn(benchmark::State& state) {
+    int n = state.range(0);
+    BBST::red_black_tree<std::uint32_t, std::less<std::uint32_t>, Allocator, NodeUpdate> tree;
+    for(int i = 0; i < n; i++)
+        tree.insert(2 * i);
+
+    std::uint32_t next = 2 * n;
+    size_t allocations = memory_tracker::allocations();
+
+    for(auto _ : state) {
+        tree.erase(tree.begin());
+        benchmark::DoNotOptimize(tree.insert(next++));
+    }
+
+    state.counters["num_keys"] = n;
+    state.counters["allocations_per_edit"] = double(memory_tracker::allocations() - allocations) / state.iterations();
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_TreeChurn, std::allocator<std::uint32_t>)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 16);
+
+BENCHMARK_TEMPLATE(BM_TreeChurn, BBST::node_pool<std::uint32_t>)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 16);
+
+BENCHMARK_TEMPLATE(BM_TreeChurn, BBST::node_pool<std::uint32_t>, BBST::order_statistics_node_update)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 16);
+
+// as BM_TreeChurn, but the least key is extracted and put back as the new one in the same node
+template <typename Allocator>
+static void BM_TreeReinsert(benchmark::State& state) {
+    int n = state.range(0);
+    BBST::red_black_tree<std::uint32_t, std::less<std::uint32_t>, Allocator> tree;
+    for(int i = 0; i < n; i++)
+        tree.insert(2 * i);
+
+    std::uint32_t next = 2 * n;
+    size_t allocations = memory_tracker::allocations();
+
+    for(auto _ : state) {
+        auto nh = tree.extract(tree.begin());
+        nh.value() = next++;
+        benchmark::DoNotOptimize(tree.insert(std::move(nh)).position);
+    }
+
+    state.counters["num_keys"] = n;
+    state.counters["allocations_per_edit"] = double(memory_tracker::allocations() - allocations) / state.iterations();
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_TreeReinsert, std::allocator<std::uint32_t>)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 16);
+
+BENCHMARK_TEMPLATE(BM_TreeReinsert, BBST::node_pool<std::uint32_t>)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 16);
+
+
+// the number of keys less than a random one in a tree of n keys, as the number of segments below a point
+// of the sweepline, by walking up to it or from the subtree sizes
+template <typename NodeUpdate>
+static void BM_TreeRank(benchmark::State& state) {
+    int n = state.range(0);
+    BBST::red_black_tree<std::uint32_t, std::less<std::uint32_t>, BBST::node_pool<std::uint32_t>, NodeUpdate> tree;
+    for(int i = 0; i < n; i++)
+        tree.insert(2 * i);
+
+    std::mt19937 rng(24);
+    std::uniform_int_distribution<std::uint32_t> key(0, 2 * n);
+
+    for(auto _ : state) {
+        std::uint32_t x = key(rng);
+        if constexpr(std::is_same_v<NodeUpdate, BBST::order_statistics_node_update>)
+            benchmark::DoNotOptimize(tree.order_of_key(x));
+        else
+            benchmark::DoNotOptimize(std::distance(tree.begin(), tree.lower_bound(x)));
+    }
+
+    state.counters["num_keys"] = n;
+    state.SetItemsProcessed(state.iterations());
+    state.SetComplexityN(n);
+}
+
+BENCHMARK_TEMPLATE(BM_TreeRank, BBST::null_node_update)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 16)
+    ->Complexity(benchmark::oN);
+
+BENCHMARK_TEMPLATE(BM_TreeRank, BBST::order_statistics_node_update)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 16)
+    ->Complexity(benchmark::oLogN);
+
+
+// a tree built from n sorted keys, one key at a time or as a whole in linear time
+template <bool Bulk>
+static void BM_TreeBuild(benchmark::State& state) {
+    int n = state.range(0);
+    std::vector<std::uint32_t> keys(n);
+    for(int i = 0; i < n; i++)
+        keys[i] = 2 * i;
+
+    for(auto _ : state) {
+        BBST::red_black_tree<std::uint32_t> tree;
+        if constexpr(Bulk)
+            tree.insert(keys.begin(), keys.end());
+        else
+            for(std::uint32_t key: keys)
+                tree.insert(key);
+        benchmark::DoNotOptimize(tree.begin());
+    }
+
+    state.counters["num_keys"] = n;
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetComplexityN(n);
+}
+
+BENCHMARK_TEMPLATE(BM_TreeBuild, false)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 20)
+    ->Complexity(benchmark::oNLogN);
+
+BENCHMARK_TEMPLATE(BM_TreeBuild, true)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 20)
+    ->Complexity(benchmark::oN);
+
+// n sorted keys past the greatest of a tree of n keys, inserted one key at a time or appended as a range
+template <bool Bulk>
+static void BM_TreeAppend(benchmark::State& state) {
+    int n = state.range(0);
+    std::vector<std::uint32_t> keys(2 * n);
+    for(int i = 0; i < 2 * n; i++)
+        keys[i] = 2 * i;
+
+    for(auto _ : state) {
+        state.PauseTiming();
+        BBST::red_black_tree<std::uint32_t> tree(keys.begin(), keys.begin() + n);
+        state.ResumeTiming();
+
+        if constexpr(Bulk)
+            tree.insert(keys.begin() + n, keys.end());
+        else
+            for(auto it = keys.begin() + n; it != keys.end(); ++it)
+                tree.insert(*it);
+        benchmark::DoNotOptimize(tree.begin());
+
+        state.PauseTiming();
+        { auto discard = std::move(tree); }   // destroyed outside of the timed loop
+        state.ResumeTiming();
+    }
+
+    state.counters["num_keys"] = n;
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK_TEMPLATE(BM_TreeAppend, false)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 16);
+
+BENCHMARK_TEMPLATE(BM_TreeAppend, true)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 16);
+
 BENCHMARK_MAIN();
 
 /*
 ./bench --benchmark_counters_tabular=true
 ./bench --benchmark_counters_tabular=true --benchmark_format=csv
+./bench --benchmark_filter=Parallel --benchmark_format=csv > ../report/benchmark_parallel.csv
 */
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include <generators.hpp>
+#include <cmath>
+#include <utility>
+
+std::vector<geometry::isegment_t<std::int64_t>> generators::to_integer(const std::vector<geometry::segment_t> &segments) {
+    std::vector<geometry::isegment_t<std::int64_t>> res;
+    res.reserve(segments.size());
+
+    for(auto &seg: segments) {
+        geometry::ipoint_t<std::int64_t> p { std::llround(seg.p.x), std::llround(seg.p.y) };
+        geometry::ipoint_t<std::int64_t> q { std::llround(seg.q.x), std::llround(seg.q.y) };
+
+        // end points rounded to the same x may swap
+        if(std::make_pair(p.x, p.y) > std::make_pair(q.x, q.y))
+            std::swap(p, q);
+
+        res.push_back({ p, q, seg.seg_id });
+    }
+
+    return res;
+}
+
+std::vector<geometry::segment_t> generators::to_float(const std::vector<geometry::isegment_t<std::int64_t>> &segments) {
+    std::vector<geometry::segment_t> res;
+    res.reserve(segments.size());
+
+    for(auto &seg: segments)
+        res.push_back({
+            geometry::point_t{ geometry::float_t(seg.p.x), geometry::float_t(seg.p.y) },
+            geometry::point_t{ geometry::float_t(seg.q.x), geometry::float_t(seg.q.y) },
+            seg.seg_id
+        });
+
+    return res;
+}
@@ -0,0 +1,15 @@
+#include <generators.hpp>
+#include <random>
+
+std::vector<geometry::segment_t> generators::gen_long_segments(size_t num_segments, size_t seed) {
+    std::vector<geometry::segment_t> res;
+    std::mt19937 rng(seed);
+    const geometry::float_t range = 1e4;
+    std::uniform_real_distribution<geometry::float_t> coord(-range, range);
+
+    // every segment spans the whole range in x, so about half of all pairs cross
+    for(size_t i = 0; i < num_segments; i++)
+        res.push_back({ geometry::point_t{ -range, coord(rng) }, geometry::point_t{ range, coord(rng) }, i });
+
+    return res;
+}
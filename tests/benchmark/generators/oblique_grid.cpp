@@ -3,7 +3,7 @@
 std::vector<geometry::segment_t> generators::gen_oblique_grid(size_t num_horiz, size_t num_verti) {
     std::vector<geometry::segment_t> res;
     size_t cnt = 0;
-    const size_t N = 1e6;
+    const geometry::float_t N = 1e6;
     for(size_t i = 0; i < num_horiz; i++) {
         geometry::float_t x1 = -N, y1 = -N + i * N / num_horiz;
         geometry::float_t x2 = N, y2 = y1 + 2 * N;
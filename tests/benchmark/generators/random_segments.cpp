@@ -0,0 +1,21 @@
+#include <generators.hpp>
+#include <random>
+
+std::vector<geometry::segment_t> generators::gen_random_segments(size_t num_segments, size_t seed) {
+    std::vector<geometry::segment_t> res;
+    std::mt19937 rng(seed);
+    const geometry::float_t range = 1e4, max_len = 100;
+    std::uniform_real_distribution<geometry::float_t> coord(-range, range), delta(-max_len, max_len);
+
+    for(size_t i = 0; i < num_segments; i++) {
+        geometry::point_t p { coord(rng), coord(rng) };
+        geometry::point_t q { p.x + delta(rng), p.y + delta(rng) };
+
+        if(std::make_pair(p.x, p.y) > std::make_pair(q.x, q.y))
+            std::swap(p, q);
+
+        res.push_back({ p, q, i });
+    }
+
+    return res;
+}
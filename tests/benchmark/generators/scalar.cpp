@@ -0,0 +1,29 @@
+#include <generators.hpp>
+
+std::vector<geometry::segment_t> generators::scale(const std::vector<geometry::segment_t> &segments, geometry::float_t factor) {
+    std::vector<geometry::segment_t> res;
+    res.reserve(segments.size());
+
+    for(auto &seg: segments)
+        res.push_back({
+            geometry::point_t{ seg.p.x * factor, seg.p.y * factor },
+            geometry::point_t{ seg.q.x * factor, seg.q.y * factor },
+            seg.seg_id
+        });
+
+    return res;
+}
+
+std::vector<geometry::basic_segment<float>> generators::to_single_precision(const std::vector<geometry::segment_t> &segments) {
+    std::vector<geometry::basic_segment<float>> res;
+    res.reserve(segments.size());
+
+    for(auto &seg: segments)
+        res.push_back({
+            geometry::basic_point<float>{ float(seg.p.x), float(seg.p.y) },
+            geometry::basic_point<float>{ float(seg.q.x), float(seg.q.y) },
+            seg.seg_id
+        });
+
+    return res;
+}
@@ -0,0 +1,25 @@
+#include <generators.hpp>
+#include <random>
+
+std::vector<std::vector<geometry::segment_t>> generators::gen_tiles(size_t num_tiles, size_t min_segments, size_t max_segments, size_t seed) {
+    std::vector<std::vector<geometry::segment_t>> res(num_tiles);
+    std::mt19937 rng(seed);
+    const geometry::float_t range = 500, max_len = 100;
+    std::uniform_real_distribution<geometry::float_t> coord(-range, range), delta(-max_len, max_len);
+    std::uniform_int_distribution<size_t> num_segments(min_segments, max_segments);
+
+    for(auto &tile: res) {
+        size_t n = num_segments(rng);
+        for(size_t i = 0; i < n; i++) {
+            geometry::point_t p { coord(rng), coord(rng) };
+            geometry::point_t q { p.x + delta(rng), p.y + delta(rng) };
+
+            if(std::make_pair(p.x, p.y) > std::make_pair(q.x, q.y))
+                std::swap(p, q);
+
+            tile.push_back({ p, q, i });
+        }
+    }
+
+    return res;
+}
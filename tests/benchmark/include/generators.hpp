@@ -1,6 +1,9 @@
 #pragma once
 
 #include <segment.hpp>
+#include <exact.hpp>
+
+#include <cstdint>
 #include <vector>
 
 namespace generators {
@@ -9,4 +12,18 @@ std::vector<geometry::segment_t> gen_oblique_grid(size_t num_horiz, size_t num_v
 
 std::vector<geometry::segment_t> gen_origin_star(size_t num_segments);
 
+std::vector<geometry::segment_t> gen_random_segments(size_t num_segments, size_t seed = 1);
+
+std::vector<geometry::segment_t> gen_long_segments(size_t num_segments, size_t seed = 1);
+
+std::vector<std::vector<geometry::segment_t>> gen_tiles(size_t num_tiles, size_t min_segments = 10, size_t max_segments = 500, size_t seed = 1);
+
+std::vector<geometry::isegment_t<std::int64_t>> to_integer(const std::vector<geometry::segment_t> &segments);
+
+std::vector<geometry::segment_t> to_float(const std::vector<geometry::isegment_t<std::int64_t>> &segments);
+
+std::vector<geometry::segment_t> scale(const std::vector<geometry::segment_t> &segments, geometry::float_t factor);
+
+std::vector<geometry::basic_segment<float>> to_single_precision(const std::vector<geometry::segment_t> &segments);
+
 } // namespace generators
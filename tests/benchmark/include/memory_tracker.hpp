@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+
+// counts the bytes held by operator new across all threads, for benchmarks to report their peak memory
+namespace memory_tracker {
+
+// the bytes currently allocated
+size_t current_bytes();
+
+// the most bytes allocated at once since the last call to reset_peak()
+size_t peak_bytes();
+
+// restarts the peak from the bytes currently allocated
+void reset_peak();
+
+// the number of calls to operator new so far
+size_t allocations();
+
+} // namespace memory_tracker
@@ -0,0 +1,54 @@
+#include <memory_tracker.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <malloc.h>
+
+namespace {
+
+std::atomic<size_t> current { 0 }, peak { 0 }, num_allocations { 0 };
+
+void *tracked_alloc(size_t size) {
+    void *ptr = std::malloc(size? size : 1);
+    if(!ptr)
+        throw std::bad_alloc();
+
+    num_allocations++;
+    size_t now = current += malloc_usable_size(ptr);
+    for(size_t prev = peak; prev < now and !peak.compare_exchange_weak(prev, now); );
+    return ptr;
+}
+
+void tracked_free(void *ptr) {
+    if(!ptr)
+        return;
+
+    current -= malloc_usable_size(ptr);
+    std::free(ptr);
+}
+
+} // namespace
+
+size_t memory_tracker::current_bytes() {
+    return current;
+}
+
+size_t memory_tracker::peak_bytes() {
+    return peak;
+}
+
+void memory_tracker::reset_peak() {
+    peak = size_t(current);
+}
+
+size_t memory_tracker::allocations() {
+    return num_allocations;
+}
+
+void *operator new(size_t size) { return tracked_alloc(size); }
+void *operator new[](size_t size) { return tracked_alloc(size); }
+void operator delete(void *ptr) noexcept { tracked_free(ptr); }
+void operator delete[](void *ptr) noexcept { tracked_free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { tracked_free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { tracked_free(ptr); }
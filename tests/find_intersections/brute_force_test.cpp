@@ -0,0 +1,244 @@
+#include <gtest/gtest.h>
+#include <sweepline.hpp>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace {
+
+class BruteForce : public testing::Test {
+
+protected:
+
+    std::vector<geometry::segment_t> random_segments(size_t n, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<geometry::float_t> coord(-1000, 1000), len(-100, 100);
+
+        std::vector<geometry::segment_t> segments;
+        for(size_t i = 0; i < n; i++) {
+            geometry::float_t x1 = coord(rng), y1 = coord(rng);
+            geometry::float_t x2 = x1 + len(rng), y2 = y1 + len(rng);
+
+            if(std::make_pair(x1, y1) > std::make_pair(x2, y2))
+                std::swap(x1, x2), std::swap(y1, y2);
+
+            segments.emplace_back(geometry::segment_t{ geometry::point_t{ x1, y1 }, geometry::point_t{ x2, y2 }, i });
+        }
+
+        return segments;
+    }
+
+    // GPS traces are given in degrees to a fixed number of decimals, here on a lattice of 2^-30 degrees (about a tenth of
+    // a millimetre) around San Francisco, so that every coordinate is exact and the lattice_ functions below are exact too
+    static constexpr geometry::float_t gps_lon = -122.4, gps_lat = 37.7, gps_unit = 0x1p-30;
+
+    // segments within 0.01 degrees of (gps_lon, gps_lat) and up to len degrees long along each axis
+    std::vector<geometry::segment_t> gps_segments(size_t n, unsigned seed, geometry::float_t len = 0.002) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<std::int64_t> coord(-0.01 / gps_unit, 0.01 / gps_unit), delta(-len / gps_unit, len / gps_unit);
+
+        std::vector<geometry::segment_t> segments;
+        for(size_t i = 0; i < n; i++) {
+            std::int64_t x1 = coord(rng), y1 = coord(rng);
+            std::int64_t x2 = x1 + delta(rng), y2 = y1 + delta(rng);
+
+            if(std::make_pair(x1, y1) > std::make_pair(x2, y2))
+                std::swap(x1, x2), std::swap(y1, y2);
+
+            segments.push_back({ { gps_lon + x1 * gps_unit, gps_lat + y1 * gps_unit },
+                { gps_lon + x2 * gps_unit, gps_lat + y2 * gps_unit }, i });
+        }
+
+        return segments;
+    }
+
+    // the coordinates of a point of gps_segments() on the lattice
+    static std::pair<std::int64_t, std::int64_t> lattice_point(const geometry::point_t &pt) {
+        return { std::int64_t((pt.x - gps_lon) / gps_unit), std::int64_t((pt.y - gps_lat) / gps_unit) };
+    }
+
+    // whether two segments of gps_segments() intersect, end points included, from exact orientations on the lattice
+    static bool lattice_intersecting(const geometry::segment_t &a, const geometry::segment_t &b) {
+        auto [p1, q1] = std::pair{ lattice_point(a.p), lattice_point(a.q) };
+        auto [p2, q2] = std::pair{ lattice_point(b.p), lattice_point(b.q) };
+
+        // the sign of the cross product of q - p and r - p, which is at most 2^49 in magnitude
+        auto orientation = [](auto p, auto q, auto r) {
+            std::int64_t cross = (q.first - p.first) * (r.second - p.second) - (q.second - p.second) * (r.first - p.first);
+            return (cross > 0) - (cross < 0);
+        };
+
+        // whether r, collinear with p and q, lies between them
+        auto between = [](auto p, auto q, auto r) {
+            return std::min(p.first, q.first) <= r.first and r.first <= std::max(p.first, q.first)
+                and std::min(p.second, q.second) <= r.second and r.second <= std::max(p.second, q.second);
+        };
+
+        int o1 = orientation(p1, q1, p2), o2 = orientation(p1, q1, q2);
+        int o3 = orientation(p2, q2, p1), o4 = orientation(p2, q2, q1);
+
+        if(o1 != o2 and o3 != o4 and o1 * o2 <= 0 and o3 * o4 <= 0)
+            return true;
+
+        return (o1 == 0 and between(p1, q1, p2)) or (o2 == 0 and between(p1, q1, q2))
+            or (o3 == 0 and between(p2, q2, p1)) or (o4 == 0 and between(p2, q2, q1));
+    }
+
+    // segments in the square [-1, 1] x [-1, 1] moved by offset, one in six of them steep
+    std::vector<geometry::segment_t> steep_segments(size_t n, unsigned seed, geometry::float_t offset) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<geometry::float_t> coord(-1, 1), len(-0.5, 0.5), slope(-50, 50);
+
+        std::vector<geometry::segment_t> segments;
+        for(size_t i = 0; i < n; i++) {
+            geometry::float_t x1 = coord(rng), y1 = coord(rng);
+            geometry::float_t x2 = x1 + len(rng), y2 = y1 + len(rng);
+            if(rng() % 6 == 0)
+                y2 = y1 + slope(rng) * std::fabs(x2 - x1);
+
+            x1 += offset, y1 += offset, x2 += offset, y2 += offset;
+            if(std::make_pair(x1, y1) > std::make_pair(x2, y2))
+                std::swap(x1, x2), std::swap(y1, y2);
+
+            segments.emplace_back(geometry::segment_t{ geometry::point_t{ x1, y1 }, geometry::point_t{ x2, y2 }, i });
+        }
+
+        return segments;
+    }
+
+    // the oblique grid of the benchmarks, scaled to the square [-1, 1] x [-1, 1]
+    std::vector<geometry::segment_t> oblique_grid(size_t num_horiz, size_t num_verti) {
+        std::vector<geometry::segment_t> segments;
+        for(size_t i = 0; i < num_horiz; i++) {
+            geometry::float_t y = -1 + geometry::float_t(i) / num_horiz;
+            segments.push_back({ { -1, y }, { 1, y + 2 }, segments.size() });
+        }
+
+        for(size_t i = 0; i < num_verti; i++) {
+            geometry::float_t y = 1 + geometry::float_t(i) / num_verti;
+            segments.push_back({ { -1, y }, { 1, y - 2 }, segments.size() });
+        }
+
+        return segments;
+    }
+
+    void expect_same_as_brute_force(const std::vector<geometry::segment_t> &segments) {
+        std::set<std::pair<size_t, size_t>> expected, received;
+
+        for(size_t i = 0; i < segments.size(); i++)
+            for(size_t j = i + 1; j < segments.size(); j++)
+                if(geometry::is_intersecting(segments[i], segments[j]))
+                    expected.emplace(i, j);
+
+        // every pair of segments through a point intersects there
+        for(auto &it: sweepline::find_intersections(segments))
+            for(size_t i = 0; i < it.segments.size(); i++)
+                for(size_t j = i + 1; j < it.segments.size(); j++)
+                    received.emplace(it.segments[i], it.segments[j]);
+
+        EXPECT_EQ(expected, received);
+    }
+
+};
+
+TEST_F(BruteForce, RandomSegments) {
+    for(unsigned seed = 1; seed <= 5; seed++) {
+        SCOPED_TRACE(seed);
+        expect_same_as_brute_force(random_segments(2000, seed));
+    }
+}
+
+TEST_F(BruteForce, ObliqueGrid) {
+    // counts which are not powers of two leave the intersections at inexact, nearly equal x coordinates
+    for(auto [num_horiz, num_verti]: { std::pair{ 6, 10 }, { 5, 7 }, { 100, 37 } }) {
+        SCOPED_TRACE(std::to_string(num_horiz) + "x" + std::to_string(num_verti));
+        expect_same_as_brute_force(oblique_grid(num_horiz, num_verti));
+    }
+}
+
+TEST_F(BruteForce, GpsScale) {
+    // the solver sweeps in a frame fitted to the input, in which crossings a few metres apart lie far beyond EPS
+    // of one another, so every pair is found exactly; the last input is dense, with segments as long as it is wide
+    for(auto [seed, len]: { std::pair{ 1u, 0.002 }, { 2u, 0.002 }, { 3u, 0.002 }, { 30u, 0.002 }, { 4u, 0.02 } }) {
+        SCOPED_TRACE(testing::Message() << "seed " << seed << ", len " << len);
+        auto segments = gps_segments(2000, seed, len);
+
+        std::set<std::pair<size_t, size_t>> expected, received;
+        for(size_t i = 0; i < segments.size(); i++)
+            for(size_t j = i + 1; j < segments.size(); j++)
+                if(lattice_intersecting(segments[i], segments[j]))
+                    expected.emplace(i, j);
+
+        for(auto &it: sweepline::solver(segments, false, false).solve())
+            for(size_t i = 0; i < it.segments.size(); i++)
+                for(size_t j = i + 1; j < it.segments.size(); j++)
+                    received.emplace(it.segments[i], it.segments[j]);
+        auto counts = sweepline::solver(segments, false, false).count();
+
+        EXPECT_EQ(expected, received);
+        EXPECT_EQ(counts.num_pairs, received.size());
+    }
+}
+
+TEST_F(BruteForce, QueryWindow) {
+    // crossings this close to a side of the window may fall either way
+    constexpr geometry::float_t tol = 1e-9;
+
+    for(unsigned seed = 1; seed <= 60; seed++) {
+        SCOPED_TRACE(seed);
+
+        // where the segments are cut at the window may not depend on where the input lies
+        geometry::float_t offset = std::array<geometry::float_t, 3>{ 0, -7.123456789, 1000.37 }[seed % 3];
+        auto segments = steep_segments(300, seed, offset);
+
+        std::map<std::pair<size_t, size_t>, geometry::point_t> crossings;
+        for(size_t i = 0; i < segments.size(); i++)
+            for(size_t j = i + 1; j < segments.size(); j++)
+                if(geometry::is_intersecting(segments[i], segments[j]))
+                    crossings.emplace(std::pair{ i, j }, geometry::intersection_point(segments[i], segments[j]));
+
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<geometry::float_t> coord(-1, 1);
+        for(int w = 0; w < 10; w++) {
+            geometry::point_t a { coord(rng) + offset, coord(rng) + offset }, b { coord(rng) + offset, coord(rng) + offset };
+            sweepline::query_window window { { std::min(a.x, b.x), std::min(a.y, b.y) }, { std::max(a.x, b.x), std::max(a.y, b.y) } };
+
+            // and a few windows with a corner on a crossing
+            auto corner = std::next(crossings.begin(), rng() % crossings.size())->second;
+            if(w % 3 == 1)
+                window.lo = corner;
+            else if(w % 3 == 2)
+                window.hi = corner, window.lo = { corner.x - 1, corner.y - 1 };
+
+            auto near_side = [&](const geometry::point_t &pt) {
+                return std::fabs(pt.x - window.lo.x) < tol or std::fabs(pt.x - window.hi.x) < tol
+                    or std::fabs(pt.y - window.lo.y) < tol or std::fabs(pt.y - window.hi.y) < tol;
+            };
+
+            std::set<std::pair<size_t, size_t>> expected, received;
+            for(auto &[pair, pt]: crossings)
+                if(window.contains(pt) and !near_side(pt))
+                    expected.insert(pair);
+
+            for(auto &it: sweepline::find_intersections(segments, window))
+                for(size_t i = 0; i < it.segments.size(); i++)
+                    for(size_t j = i + 1; j < it.segments.size(); j++) {
+                        auto pos = crossings.find({ it.segments[i], it.segments[j] });
+                        if(pos == crossings.end() or !near_side(pos->second))
+                            received.emplace(it.segments[i], it.segments[j]);
+                    }
+
+            EXPECT_EQ(expected, received) << "window " << w;
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <sweepline.hpp>
+#include <thread_pool.hpp>
+#include "data_files.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+class Concurrency : public testing::Test {};
+
+// Runs find_intersections() on several inputs from many threads at once
+// and checks every result against the one computed on a single thread
+TEST_F(Concurrency, FindIntersectionsFromManyThreads) {
+    const std::vector<std::string> files {
+        "complicated_sample_test.txt",
+        "edge_case_star.txt",
+        "edge_case_grid_lines_with_single_oblique.txt",
+        "edge_case_vertical_oblique_cross.txt",
+        "oblique_parallel_lines.txt",
+        "star_at_origin.txt",
+        "rand1.txt"
+    };
+
+    std::vector<std::vector<geometry::segment_t>> inputs;
+    std::vector<std::vector<sweepline::intersection_t>> expected;
+    for(auto &f: files) {
+        inputs.push_back(data_files::input(f));
+        expected.push_back(sweepline::find_intersections(inputs.back()));
+    }
+
+    const size_t num_threads = 8, rounds = 6;
+    std::vector<std::vector<std::vector<sweepline::intersection_t>>> received(num_threads);
+
+    std::vector<std::thread> threads;
+    for(size_t t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t] {
+            // each thread starts at a different input so that different inputs overlap in time
+            for(size_t r = 0; r < rounds * inputs.size(); r++)
+                received[t].push_back(sweepline::find_intersections(inputs[(t + r) % inputs.size()]));
+        });
+    }
+
+    for(auto &th: threads)
+        th.join();
+
+    for(size_t t = 0; t < num_threads; t++)
+        for(size_t r = 0; r < received[t].size(); r++)
+            data_files::expect_identical(expected[(t + r) % inputs.size()], received[t][r]);
+}
+
+// Runs many small instances through find_intersections_batch(), which reuses one solver per worker,
+// and checks every result against a fresh solver
+TEST_F(Concurrency, BatchReusesSolvers) {
+    const std::vector<std::string> files {
+        "complicated_sample_test.txt",
+        "edge_case_star.txt",
+        "edge_case_butterfly.txt",
+        "edge_case_vertical_parallel.txt",
+        "edge_case_triangle_in_triangle.txt",
+        "sample_test.txt",
+        "rand1.txt"
+    };
+
+    std::vector<std::vector<geometry::segment_t>> inputs;
+    std::vector<std::vector<sweepline::intersection_t>> expected;
+    for(auto &f: files) {
+        inputs.push_back(data_files::input(f));
+        expected.push_back(sweepline::find_intersections(inputs.back()));
+    }
+
+    const size_t rounds = 20;
+    std::vector<std::vector<geometry::segment_t>> instances;
+    for(size_t r = 0; r < rounds * inputs.size(); r++)
+        instances.push_back(inputs[r % inputs.size()]);
+
+    sweepline::thread_pool pool(4);
+    for(size_t batch = 0; batch < 3; batch++) {
+        auto received = sweepline::find_intersections_batch(instances, pool);
+
+        ASSERT_EQ(received.size(), instances.size());
+        for(size_t r = 0; r < received.size(); r++)
+            data_files::expect_identical(expected[r % inputs.size()], received[r]);
+    }
+}
+
+// Tasks of very uneven length must each run exactly once, with work stolen across workers
+TEST_F(Concurrency, ThreadPoolRunsEveryTaskOnce) {
+    sweepline::thread_pool pool(4);
+
+    for(size_t num_tasks: { 1, 3, 4, 100, 1000 }) {
+        std::vector<std::atomic<size_t>> runs(num_tasks);
+        std::vector<size_t> worker_of(num_tasks);
+
+        pool.run(num_tasks, [&](size_t i, size_t worker) {
+            // the first few tasks are far longer than the rest
+            volatile size_t spin = i < 4? 2000000 : 100;
+            while(spin)
+                spin = spin - 1;
+
+            runs[i]++;
+            worker_of[i] = worker;
+        });
+
+        for(size_t i = 0; i < num_tasks; i++) {
+            EXPECT_EQ(runs[i], 1u);
+            EXPECT_LT(worker_of[i], pool.size());
+        }
+    }
+
+    // an exception is rethrown once the batch is over, and the pool keeps working
+    EXPECT_THROW(pool.run(10, [](size_t i) { if(i == 7) throw std::runtime_error("task 7"); }), std::runtime_error);
+
+    std::atomic<size_t> sum { 0 };
+    pool.run(10, [&](size_t i) { sum += i; });
+    EXPECT_EQ(sum, 45u);
+}
+
+} // namespace
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <sweepline.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// reads the data files the tests run on, and compares intersections found against those expected
+namespace data_files {
+
+// the segments of an input file, each with its end points in order and its line number as id, 0-based
+template <typename Segment = geometry::segment_t>
+std::vector<Segment> input(const std::string &fname) {
+    using T = std::decay_t<decltype(Segment().p.x)>;
+    std::ifstream fin(fname);
+
+    size_t n;       // number of input segments
+    fin >> n;
+
+    std::vector<Segment> segments;
+    segments.reserve(n);
+
+    for(size_t i = 0; i < n; i++) {
+        T x1, y1, x2, y2;
+        fin >> x1 >> y1 >> x2 >> y2;
+
+        if(std::make_pair(x1, y1) > std::make_pair(x2, y2))
+            std::swap(x1, x2), std::swap(y1, y2);
+
+        segments.push_back(Segment{ { x1, y1 }, { x2, y2 }, i });
+    }
+
+    return segments;
+}
+
+// orders intersections by point, points closer than the tolerance of their scalar type being equal
+template <typename Intersection>
+std::vector<Intersection> sorted(std::vector<Intersection> &&result) {
+    using T = std::decay_t<decltype(Intersection().pt.x)>;
+    constexpr T eps = geometry::tolerance<T>;
+    std::sort(result.begin(), result.end(),
+        [](const Intersection &lhs, const Intersection &rhs) {
+            return std::fabs(lhs.pt.x - rhs.pt.x) < eps? lhs.pt.y < rhs.pt.y - eps : lhs.pt.x < rhs.pt.x - eps;
+        }
+    );
+    return std::move(result);
+}
+
+// the intersections of an expected output file, with segment ids 0-based and sorted, ordered by point
+template <typename Intersection = sweepline::intersection_t>
+std::vector<Intersection> expected_output(const std::string &fname) {
+    std::ifstream fin(fname);
+
+    size_t m;       // number of intersection points
+    fin >> m;
+
+    std::vector<Intersection> result(m);
+    for(auto &it: result) {
+        fin >> it.pt.x >> it.pt.y;
+
+        size_t idx;
+        std::string s;
+        std::getline(fin, s);
+        std::istringstream iss(s);
+        while(iss >> idx)
+            it.segments.push_back(idx - 1);     // 1-based -> 0-based
+
+        std::sort(it.segments.begin(), it.segments.end());
+    }
+
+    return sorted(std::move(result));
+}
+
+// the same intersections in the same order, the points compared by their == within tolerance
+template <typename Expected, typename Received>
+void expect_same(const std::vector<Expected> &expected, const std::vector<Received> &received) {
+    ASSERT_EQ(expected.size(), received.size());
+    for(size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(expected[i].pt, received[i].pt) << "intersection " << i;
+        /* segment ids are uint, so no precision errors to worry about */
+        EXPECT_EQ(expected[i].segments, received[i].segments) << "intersection " << i;
+    }
+}
+
+// the same intersections in the same order, bit for bit, for results of the exact same floating point operations
+template <typename Intersection>
+void expect_identical(const std::vector<Intersection> &expected, const std::vector<Intersection> &received) {
+    ASSERT_EQ(expected.size(), received.size());
+    for(size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(expected[i].pt.x, received[i].pt.x) << "intersection " << i;
+        EXPECT_EQ(expected[i].pt.y, received[i].pt.y) << "intersection " << i;
+        EXPECT_EQ(expected[i].segments, received[i].segments) << "intersection " << i;
+    }
+}
+
+} // namespace data_files
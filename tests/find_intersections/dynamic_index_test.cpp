@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include <dynamic_index.hpp>
+#include "data_files.hpp"
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+class DynamicIndex : public testing::Test {
+
+protected:
+
+    static geometry::segment_t random_segment(std::mt19937 &rng, size_t id) {
+        std::uniform_real_distribution<geometry::float_t> coord(-1000, 1000), len(-200, 200);
+        geometry::float_t x1 = coord(rng), y1 = coord(rng);
+        geometry::float_t x2 = x1 + len(rng), y2 = y1 + len(rng);
+
+        if(std::make_pair(x1, y1) > std::make_pair(x2, y2))
+            std::swap(x1, x2), std::swap(y1, y2);
+
+        return geometry::segment_t{ geometry::point_t{ x1, y1 }, geometry::point_t{ x2, y2 }, id };
+    }
+
+    // recomputes every intersection from scratch, with ids of the segments in the map
+    static std::vector<sweepline::intersection_t> recompute(const std::map<size_t, geometry::segment_t> &segments) {
+        std::vector<geometry::segment_t> renumbered;
+        std::vector<size_t> ids;
+        for(auto &[id, seg]: segments) {
+            renumbered.push_back(geometry::segment_t{ seg.p, seg.q, renumbered.size() });
+            ids.push_back(id);
+        }
+
+        // ids are renumbered in increasing order, so the segments of each intersection stay sorted
+        auto result = sweepline::find_intersections(renumbered);
+        for(auto &it: result)
+            for(size_t &idx: it.segments)
+                idx = ids[idx];
+
+        return result;
+    }
+
+};
+
+TEST_F(DynamicIndex, MatchesFindIntersections) {
+    for(auto fname: {
+        "complicated_sample_test.txt",
+        "edge_case_star.txt",
+        "edge_case_butterfly.txt",
+        "edge_case_vertical_oblique_cross.txt",
+        "edge_case_grid_lines_with_single_oblique.txt",
+        "rand1.txt"
+    }) {
+        SCOPED_TRACE(fname);
+        auto segments = data_files::input(fname);
+        data_files::expect_same(sweepline::find_intersections(segments), sweepline::dynamic_index(segments).intersections());
+    }
+}
+
+// Applies random sequences of inserts and erases, and checks the index and the reported changes
+// against a full recompute after every few edits
+TEST_F(DynamicIndex, RandomEdits) {
+    for(unsigned seed = 1; seed <= 5; seed++) {
+        SCOPED_TRACE(seed);
+        std::mt19937 rng(seed);
+
+        std::map<size_t, geometry::segment_t> segments;
+        size_t next_id = 0;
+        for(; next_id < 300; next_id++)
+            segments[next_id] = random_segment(rng, next_id);
+
+        std::vector<geometry::segment_t> initial;
+        for(auto &[id, seg]: segments)
+            initial.push_back(seg);
+
+        sweepline::dynamic_index index(initial);
+
+        // the pairs of intersecting segments, kept up to date from the changes alone
+        std::set<std::pair<size_t, size_t>> pairs;
+        for(auto &it: index.intersections())
+            for(size_t a = 0; a < it.segments.size(); a++)
+                for(size_t b = a + 1; b < it.segments.size(); b++)
+                    pairs.insert({ it.segments[a], it.segments[b] });
+
+        for(size_t edit = 1; edit <= 400; edit++) {
+            if(segments.empty() or rng() % 2) {
+                auto seg = random_segment(rng, next_id++);
+                segments[seg.seg_id] = seg;
+
+                for(auto &it: index.insert(seg))
+                    EXPECT_TRUE(pairs.insert({ it.segments[0], it.segments[1] }).second);
+            } else {
+                auto victim = std::next(segments.begin(), rng() % segments.size());
+                size_t id = victim->first;
+                segments.erase(victim);
+
+                for(auto &it: index.erase(id))
+                    EXPECT_EQ(pairs.erase({ it.segments[0], it.segments[1] }), 1u);
+            }
+
+            ASSERT_EQ(index.size(), segments.size());
+
+            if(edit % 50)
+                continue;
+
+            auto expected = recompute(segments);
+            data_files::expect_same(expected, index.intersections());
+
+            std::set<std::pair<size_t, size_t>> expected_pairs;
+            for(auto &it: expected)
+                for(size_t a = 0; a < it.segments.size(); a++)
+                    for(size_t b = a + 1; b < it.segments.size(); b++)
+                        expected_pairs.insert({ it.segments[a], it.segments[b] });
+            EXPECT_EQ(expected_pairs, pairs);
+        }
+    }
+}
+
+TEST_F(DynamicIndex, EraseUnknownAndDuplicateInsert) {
+    sweepline::dynamic_index index(10);
+    geometry::segment_t seg { geometry::point_t{ 0, 0 }, geometry::point_t{ 10, 10 }, 7 };
+
+    EXPECT_TRUE(index.insert(seg).empty());
+    EXPECT_THROW(index.insert(seg), std::invalid_argument);
+    EXPECT_TRUE(index.erase(8).empty());
+
+    auto gained = index.insert(geometry::segment_t{ geometry::point_t{ 0, 10 }, geometry::point_t{ 10, 0 }, 3 });
+    ASSERT_EQ(gained.size(), 1u);
+    EXPECT_EQ(gained[0].pt, (geometry::point_t{ 5, 5 }));
+    EXPECT_EQ(gained[0].segments, (std::vector<size_t>{ 3, 7 }));
+
+    auto lost = index.erase(7);
+    ASSERT_EQ(lost.size(), 1u);
+    EXPECT_EQ(lost[0].segments, (std::vector<size_t>{ 3, 7 }));
+    EXPECT_FALSE(index.contains(7));
+    EXPECT_TRUE(index.intersections().empty());
+}
+
+TEST_F(DynamicIndex, InvalidCellSize) {
+    for(geometry::float_t cell_size: {
+        geometry::float_t(0), geometry::float_t(-1),
+        std::numeric_limits<geometry::float_t>::infinity(), std::numeric_limits<geometry::float_t>::quiet_NaN()
+    })
+        EXPECT_THROW(sweepline::dynamic_index index(cell_size), std::invalid_argument);
+}
+
+// A long diagonal overlaps a number of cells linear in its length, not the whole of its bounding box,
+// and still meets every segment crossing it, also those which cross it at the corners of cells
+TEST_F(DynamicIndex, LongSegmentsWalkTheirCells) {
+    sweepline::dynamic_index index(1);
+    index.insert(geometry::segment_t{ geometry::point_t{ 0, 0 }, geometry::point_t{ 1000, 1000 }, 0 });
+    EXPECT_LT(index.num_cells(), 4000u);
+
+    std::set<size_t> crossed;
+    for(size_t k = 1; k < 1000; k += 7) {
+        // through the corner (k, k) of four cells, and through the middle of a cell
+        for(auto &it: index.insert(geometry::segment_t{
+            geometry::point_t{ geometry::float_t(k) - 1, geometry::float_t(k) + 1 },
+            geometry::point_t{ geometry::float_t(k) + 1, geometry::float_t(k) - 1 }, 2 * k }))
+                crossed.insert(it.segments[1]);
+        for(auto &it: index.insert(geometry::segment_t{
+            geometry::point_t{ k + 0.25, k + 0.75 }, geometry::point_t{ k + 0.75, k + 0.25 }, 2 * k + 1 }))
+                crossed.insert(it.segments[1]);
+    }
+    EXPECT_EQ(crossed.size(), 2 * size_t((1000 - 1 + 6) / 7));
+
+    index.erase(0);
+    EXPECT_TRUE(index.intersections().empty());
+}
+
+} // namespace
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <sweepline.hpp>
+#include "data_files.hpp"
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+using event = sweepline::basic_event<double>;
+
+template <typename Queue>
+class EventQueue : public testing::Test {
+
+protected:
+
+    using solver = sweepline::basic_solver<double, Queue>;
+
+    // random segments with many crossings, some of them sharing end points or vertical
+    static std::vector<geometry::segment_t> random_segments(std::mt19937 &rng, size_t n) {
+        std::uniform_int_distribution<int> coord(-20, 20);
+        std::vector<geometry::segment_t> segments;
+
+        while(segments.size() < n) {
+            geometry::segment_t seg { { double(coord(rng)), double(coord(rng)) }, { double(coord(rng)), double(coord(rng)) }, segments.size() };
+            if(rng() % 8 == 0)
+                seg.q.x = seg.p.x;
+
+            if(std::make_pair(seg.p.x, seg.p.y) > std::make_pair(seg.q.x, seg.q.y))
+                std::swap(seg.p, seg.q);
+
+            // overlapping segments are not supported
+            bool overlaps = seg.p == seg.q or std::any_of(segments.begin(), segments.end(), [&](const geometry::segment_t &other) {
+                return geometry::cross_prod(seg.p, seg.q, other.p) == 0 and geometry::cross_prod(seg.p, seg.q, other.q) == 0
+                    and geometry::is_intersecting(seg, other);
+            });
+
+            if(!overlaps)
+                segments.push_back(seg);
+        }
+
+        return segments;
+    }
+
+};
+
+using EventQueues = testing::Types<
+    sweepline::bbst_event_queue<event>,
+    sweepline::heap_event_queue<event, 2>,
+    sweepline::heap_event_queue<event, 4>,
+    sweepline::radix_event_queue<event>
+>;
+TYPED_TEST_SUITE(EventQueue, EventQueues);
+
+TYPED_TEST(EventQueue, PopsInOrder) {
+    // events are pushed past the last one popped, as the sweep does, so that the radix heap may be used too
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> step(0, 50), y(-1000, 1000);
+
+    TypeParam queue;
+    std::set<event> expected;
+    double last_x = -500;
+    size_t id = 0;
+
+    for(int iter = 0; iter < 20000; iter++) {
+        if(rng() % 3 and !queue.empty()) {
+            ASSERT_EQ(queue.size(), expected.size());
+            event top = queue.top();
+            EXPECT_EQ(top.seg_id, expected.begin()->seg_id);
+            last_x = top.p.x;
+
+            queue.pop();
+            expected.erase(expected.begin());
+        } else {
+            event e { { last_x + step(rng), double(y(rng)) }, event::type::begin, id++ };
+            queue.push(e);
+            expected.insert(e);
+        }
+    }
+
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(EndpointEvents, RadixSort) {
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<double> coord(-1e6, 1e6);
+
+    // enough events to be partitioned by radix, with many equal keys
+    std::vector<double> xs { 0.0, -0.0, 1e-300, -1e-300, 5, 5, -5 };
+    for(int i = 0; i < 500000; i++)
+        xs.push_back(i % 2? coord(rng) : std::round(coord(rng) / 1000));
+
+    std::vector<sweepline::endpoint_event> events;
+    for(size_t i = 0; i < xs.size(); i++) {
+        events.push_back({ sweepline::radix_key(xs[i]), std::uint32_t(i), event::type::begin });
+        EXPECT_EQ(sweepline::from_radix_key<double>(events.back().key), xs[i]);
+        EXPECT_EQ(sweepline::from_radix_key<float>(sweepline::radix_key(float(xs[i]))), float(xs[i]));
+    }
+
+    sweepline::radix_sort(events);
+
+    // sorted by x, and by id among equal keys
+    ASSERT_EQ(events.size(), xs.size());
+    for(size_t i = 0; i + 1 < events.size(); i++) {
+        EXPECT_LE(xs[events[i].seg_id], xs[events[i + 1].seg_id]);
+        if(events[i].key == events[i + 1].key) {
+            EXPECT_LT(events[i].seg_id, events[i + 1].seg_id);
+        }
+    }
+}
+
+TYPED_TEST(EventQueue, DataFiles) {
+    for(std::string fname: {
+        "complicated_sample_test.txt", "edge_case_another_nested_y.txt", "edge_case_butterfly.txt",
+        "edge_case_close_parallel_lines.txt", "edge_case_coordinate_axes_1.txt", "edge_case_coordinate_axes_2.txt",
+        "edge_case_coordinate_axes_3.txt", "edge_case_disappointed_face.txt",
+        "edge_case_grid_lines_with_single_oblique.txt", "edge_case_horizontal_oblique_cross.txt",
+        "edge_case_horizontal_parallel.txt", "edge_case_narrowing_downwards.txt", "edge_case_nested_y.txt",
+        "edge_case_not_intersecting_but_close.txt", "edge_case_origin_intersect_1.txt",
+        "edge_case_origin_intersect_2.txt", "edge_case_origin_intersect_3.txt",
+        "edge_case_parallels_intersect_oblique.txt", "edge_case_star.txt", "edge_case_triangle_in_triangle.txt",
+        "edge_case_vertical_oblique_cross.txt", "edge_case_vertical_parallel.txt", "oblique_parallel_lines.txt",
+        "parallel_lines.txt", "rand1.txt", "sample_test.txt", "star_at_origin.txt"
+    }) {
+
+        SCOPED_TRACE(fname);
+        auto expected = data_files::expected_output("expected/" + fname);
+        auto received = data_files::sorted(typename TestFixture::solver(data_files::input(fname), false, false).solve());
+        data_files::expect_same(expected, received);
+    }
+}
+
+TYPED_TEST(EventQueue, ObliqueGrid) {
+    // many intersections lie at nearly equal x coordinates, which the radix heap orders strictly by x
+    for(auto [num_horiz, num_verti]: { std::pair{ 6, 10 }, { 64, 32 }, { 100, 37 } }) {
+        SCOPED_TRACE(std::to_string(num_horiz) + "x" + std::to_string(num_verti));
+
+        std::vector<geometry::segment_t> segments;
+        for(int i = 0; i < num_horiz; i++)
+            segments.push_back({ { -1, -1 + double(i) / num_horiz }, { 1, 1 + double(i) / num_horiz }, segments.size() });
+        for(int i = 0; i < num_verti; i++)
+            segments.push_back({ { -1, 1 + double(i) / num_verti }, { 1, -1 + double(i) / num_verti }, segments.size() });
+
+        auto counts = typename TestFixture::solver(segments, false, false).count();
+        EXPECT_EQ(counts.num_points, size_t(num_horiz * num_verti));
+        EXPECT_EQ(counts.num_pairs, size_t(num_horiz * num_verti));
+    }
+}
+
+TYPED_TEST(EventQueue, LongSegments) {
+    // segments spanning the whole sweep become adjacent to many others in turn, each pair scheduling
+    // its events anew, yet the queue holds only a constant number of events per segment
+    std::mt19937 rng(18);
+    std::uniform_real_distribution<double> y(-1000, 1000);
+
+    for(size_t n: { 50, 200, 400 }) {
+        SCOPED_TRACE(n);
+
+        std::vector<geometry::segment_t> segments;
+        for(size_t i = 0; i < n; i++)
+            segments.push_back({ { -1000, y(rng) }, { 1000, y(rng) }, i });
+
+        size_t expected = 0;
+        for(size_t i = 0; i < n; i++)
+            for(size_t j = 0; j < i; j++)
+                expected += geometry::is_intersecting(segments[i], segments[j]);
+
+        typename TestFixture::solver solver(segments, false, false);
+        EXPECT_EQ(solver.count().num_pairs, expected);
+
+        auto &saved = solver.event_counts();
+        EXPECT_GT(saved.duplicate_pairs, 0u);
+        EXPECT_LE(saved.max_queue_size, 4 * n + 64);
+    }
+}
+
+TYPED_TEST(EventQueue, MatchesBbst) {
+    std::mt19937 rng(13);
+
+    for(int iter = 0; iter < 200; iter++) {
+        SCOPED_TRACE(iter);
+        auto segments = this->random_segments(rng, 25);
+
+        auto expected = sweepline::basic_solver<double, sweepline::bbst_event_queue<event>>(segments, false, false).solve();
+        auto received = typename TestFixture::solver(segments, false, false).solve();
+
+        data_files::expect_same(expected, received);
+    }
+}
+
+} // namespace
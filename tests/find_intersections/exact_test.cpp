@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <exact_solver.hpp>
+#include "data_files.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace {
+
+using isegment = geometry::isegment_t<std::int64_t>;
+
+class Exact : public testing::Test {
+
+protected:
+
+    // every pair of segments, with the points merged exactly
+    static std::vector<sweepline::exact_intersection_t> brute_force(const std::vector<isegment> &segments) {
+        std::vector<sweepline::exact_intersection_t> result;
+        for(size_t i = 0; i < segments.size(); i++)
+            for(size_t j = i + 1; j < segments.size(); j++)
+                if(geometry::is_intersecting(segments[i], segments[j]))
+                    result.push_back({ geometry::intersection_point(segments[i], segments[j]), { i, j } });
+
+        std::stable_sort(result.begin(), result.end(),
+            [](const sweepline::exact_intersection_t &a, const sweepline::exact_intersection_t &b) { return a.pt < b.pt; });
+
+        std::vector<sweepline::exact_intersection_t> merged;
+        for(auto &it: result) {
+            if(merged.empty() or !(merged.back().pt == it.pt))
+                merged.push_back({ it.pt, {} });
+            merged.back().segments.insert(merged.back().segments.end(), it.segments.begin(), it.segments.end());
+        }
+
+        for(auto &it: merged) {
+            std::sort(it.segments.begin(), it.segments.end());
+            it.segments.erase(std::unique(it.segments.begin(), it.segments.end()), it.segments.end());
+        }
+
+        return merged;
+    }
+
+    // random segments on a small grid, so that many share end points, cross at end points or are vertical
+    static std::vector<isegment> random_segments(std::mt19937 &rng, size_t n, std::int64_t range) {
+        std::uniform_int_distribution<std::int64_t> coord(-range, range);
+        std::vector<isegment> segments;
+
+        auto overlaps = [](const isegment &a, const isegment &b) {
+            if(geometry::cross_prod(a.p, a.q, b.p) != 0 or geometry::cross_prod(a.p, a.q, b.q) != 0)
+                return false;
+            return std::max(std::make_pair(a.p.x, a.p.y), std::make_pair(b.p.x, b.p.y))
+                < std::min(std::make_pair(a.q.x, a.q.y), std::make_pair(b.q.x, b.q.y));
+        };
+
+        while(segments.size() < n) {
+            isegment seg { { coord(rng), coord(rng) }, { coord(rng), coord(rng) }, segments.size() };
+            if(rng() % 4 == 0)
+                seg.q.x = seg.p.x;
+
+            if(std::make_pair(seg.p.x, seg.p.y) > std::make_pair(seg.q.x, seg.q.y))
+                std::swap(seg.p, seg.q);
+
+            if(seg.p == seg.q or std::any_of(segments.begin(), segments.end(),
+                [&](const isegment &other) { return overlaps(seg, other); }))
+                    continue;
+
+            segments.push_back(seg);
+        }
+
+        return segments;
+    }
+
+};
+
+TEST_F(Exact, DataFiles) {
+    // the data files with integer coordinates only
+    for(std::string fname: {
+        "edge_case_another_nested_y.txt", "edge_case_coordinate_axes_1.txt", "edge_case_coordinate_axes_2.txt",
+        "edge_case_coordinate_axes_3.txt", "edge_case_grid_lines_with_single_oblique.txt",
+        "edge_case_horizontal_oblique_cross.txt", "edge_case_horizontal_parallel.txt",
+        "edge_case_narrowing_downwards.txt", "edge_case_nested_y.txt", "edge_case_origin_intersect_1.txt",
+        "edge_case_origin_intersect_2.txt", "edge_case_origin_intersect_3.txt",
+        "edge_case_parallels_intersect_oblique.txt", "edge_case_star.txt", "edge_case_triangle_in_triangle.txt",
+        "edge_case_vertical_oblique_cross.txt", "edge_case_vertical_parallel.txt"
+    }) {
+
+        SCOPED_TRACE(fname);
+        auto expected = data_files::expected_output("expected/" + fname);
+
+        std::vector<sweepline::intersection_t> received;
+        for(auto &it: sweepline::find_intersections(data_files::input<isegment>(fname)))
+            received.push_back({ it.pt.approx(), it.segments });
+
+        data_files::expect_same(expected, received);
+    }
+}
+
+TEST_F(Exact, MatchesBruteForce) {
+    std::mt19937 rng(3);
+
+    for(int iter = 0; iter < 300; iter++) {
+        auto segments = random_segments(rng, 12, 5);
+        SCOPED_TRACE(iter);
+        data_files::expect_same(brute_force(segments), sweepline::find_intersections(segments));
+    }
+}
+
+TEST_F(Exact, LargeCoordinates) {
+    std::mt19937 rng(5);
+    const std::int64_t range = geometry::EXACT_COORD_LIMIT - 1;
+
+    for(int iter = 0; iter < 100; iter++) {
+        auto segments = random_segments(rng, 30, range);
+        SCOPED_TRACE(iter);
+        data_files::expect_same(brute_force(segments), sweepline::find_intersections(segments));
+    }
+
+    // both diagonals of the largest square, crossing at the origin
+    std::vector<isegment> diagonals {
+        { { -range, -range }, { range, range }, 0 },
+        { { -range, range }, { range, -range }, 1 }
+    };
+    auto result = sweepline::find_intersections(diagonals);
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_TRUE(result[0].pt == (geometry::ipoint_t<std::int64_t>{ 0, 0 }));
+
+    diagonals[1].q.x = geometry::EXACT_COORD_LIMIT;
+    EXPECT_THROW(sweepline::find_intersections(diagonals), std::out_of_range);
+}
+
+TEST_F(Exact, CloseButDistinctPoints) {
+    // a long segment passing 1e-8 below the point where two others cross, so that the three pairs cross at distinct points
+    const std::int64_t n = 100'000'000;
+    std::vector<isegment> segments {
+        { { 0, 0 }, { 1000, 1000 }, 0 },
+        { { 0, 1000 }, { 1000, 0 }, 1 },
+        { { 500 - n, 499 }, { 500 + n + 1, 501 }, 2 }
+    };
+
+    auto expected = brute_force(segments);
+    auto received = sweepline::find_intersections(segments);
+    data_files::expect_same(expected, received);
+    EXPECT_EQ(received.size(), 3);
+
+    // a tolerance would have merged them into a single point
+    EXPECT_EQ(received[0].pt.approx(), received[2].pt.approx());
+}
+
+TEST_F(Exact, CountAndNarrowCoordinates) {
+    std::mt19937 rng(7);
+    auto segments = random_segments(rng, 60, 20);
+    auto expected = brute_force(segments);
+
+    size_t num_pairs = 0;
+    for(auto &it: expected)
+        num_pairs += it.segments.size() * (it.segments.size() - 1) / 2;
+
+    auto counts = sweepline::count_intersections(segments);
+    EXPECT_EQ(counts.num_points, expected.size());
+    EXPECT_EQ(counts.num_pairs, num_pairs);
+
+    // the same segments with 32 bit coordinates
+    std::vector<geometry::isegment_t<std::int32_t>> narrow;
+    for(auto &seg: segments)
+        narrow.push_back({
+            { std::int32_t(seg.p.x), std::int32_t(seg.p.y) }, { std::int32_t(seg.q.x), std::int32_t(seg.q.y) }, seg.seg_id });
+    data_files::expect_same(expected, sweepline::find_intersections(narrow));
+}
+
+} // namespace
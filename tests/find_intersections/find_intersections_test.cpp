@@ -1,9 +1,11 @@
 #include <gtest/gtest.h>
 #include <sweepline.hpp>
+#include "data_files.hpp"
 #include <iostream>
 #include <string>
 #include <fstream>
 #include <cmath>
+#include <algorithm>
 
 
 namespace {
@@ -195,4 +197,180 @@ TEST_F(EdgeCases, OriginIntersect2){
     DO_EDGE_CASE("edge_case_origin_intersect_2.txt")
 }
 
-} // namespace
\ No newline at end of file
+TEST_F(EdgeCases, StreamingSink){
+    // intersections within 2 * EPS behind the sweepline are held back, to be merged with others at the same point
+    constexpr geometry::float_t margin = 4 * geometry::EPS;
+
+    for(std::string inputf: { "edge_case_star.txt", "edge_case_grid_lines_with_single_oblique.txt",
+                              "edge_case_vertical_parallel.txt", "edge_case_horizontal_parallel.txt",
+                              "edge_case_triangle_in_triangle.txt", "star_at_origin.txt",
+                              "complicated_sample_test.txt", "rand1.txt" }) {
+        SCOPED_TRACE(inputf);
+        auto segments = data_files::input(inputf);
+        auto expected = data_files::expected_output("expected/" + inputf);
+
+        // the x coordinates of every event: the end points and the intersections
+        std::vector<geometry::float_t> event_xs;
+        for(auto &seg: segments)
+            event_xs.push_back(seg.p.x), event_xs.push_back(seg.q.x);
+        for(auto &it: expected)
+            event_xs.push_back(it.pt.x);
+        std::sort(event_xs.begin(), event_xs.end());
+
+        sweepline::basic_solver<geometry::float_t> solver(segments, false, false);
+        std::vector<sweepline::intersection_t> received;
+        solver.solve([&](sweepline::intersection_t &&it) {
+            geometry::float_t x = solver.sweepline_x();
+
+            // the sweep has reached the intersection, so no more segments can join it
+            EXPECT_LE(it.pt.x, x + margin);
+
+            // and has not gone past the next event, so nothing is buffered beyond the sweepline
+            auto next = std::upper_bound(event_xs.begin(), event_xs.end(), it.pt.x + margin);
+            if(next != event_xs.end()) {
+                EXPECT_LE(x, *next + margin);
+            }
+
+            // intersections are delivered in order of x
+            if(!received.empty()) {
+                EXPECT_GE(it.pt.x, received.back().pt.x - margin);
+            }
+
+            received.push_back(std::move(it));
+        });
+
+        // each intersection is delivered exactly once, with all of its segments
+        data_files::expect_same(expected, data_files::sorted(std::move(received)));
+    }
+}
+
+TEST_F(EdgeCases, IntersectionList){
+    for(std::string inputf: { "edge_case_star.txt", "edge_case_grid_lines_with_single_oblique.txt",
+                              "edge_case_vertical_parallel.txt", "oblique_parallel_lines.txt",
+                              "star_at_origin.txt", "rand1.txt" }) {
+        SCOPED_TRACE(inputf);
+        auto segments = data_files::input(inputf);
+        auto expected = sweepline::find_intersections(segments);
+
+        // the flat list holds exactly what the vector holds, in the same order
+        auto received = sweepline::find_intersection_list(segments);
+        ASSERT_EQ(received.size(), expected.size());
+        ASSERT_EQ(received.offsets.size(), expected.size() + 1);
+        EXPECT_EQ(received.offsets.back(), received.ids.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            EXPECT_EQ(expected[i].pt.x, received.points[i].x);
+            EXPECT_EQ(expected[i].pt.y, received.points[i].y);
+            EXPECT_EQ(expected[i].segments, received.at(i).segments);
+        }
+
+        // and converts back and forth
+        sweepline::intersection_list converted(expected);
+        EXPECT_EQ(converted.offsets, received.offsets);
+        EXPECT_EQ(converted.ids, received.ids);
+    }
+}
+
+TEST_F(EdgeCases, CountOnly){
+    for(std::string inputf: { "edge_case_star.txt", "edge_case_grid_lines_with_single_oblique.txt",
+                              "edge_case_vertical_parallel.txt", "star_at_origin.txt", "rand1.txt" }) {
+        SCOPED_TRACE(inputf);
+        auto segments = data_files::input(inputf);
+        auto expected = sweepline::find_intersections(segments);
+
+        size_t num_pairs = 0;
+        for(auto &it: expected)
+            num_pairs += it.segments.size() * (it.segments.size() - 1) / 2;
+
+        auto received = sweepline::count_intersections(segments);
+        EXPECT_EQ(received.num_points, expected.size());
+        EXPECT_EQ(received.num_pairs, num_pairs);
+    }
+}
+
+TEST_F(EdgeCases, AnyIntersection){
+    for(std::string inputf: { "edge_case_star.txt", "edge_case_butterfly.txt", "edge_case_vertical_parallel.txt",
+                              "edge_case_close_parallel_lines.txt", "edge_case_disappointed_face.txt",
+                              "edge_case_narrowing_downwards.txt", "parallel_lines.txt", "rand1.txt" }) {
+        SCOPED_TRACE(inputf);
+        auto segments = data_files::input(inputf);
+        auto expected = sweepline::find_intersections(segments);
+        auto received = sweepline::any_intersection(segments);
+
+        ASSERT_EQ(received.has_value(), !expected.empty());
+        if(!received)
+            continue;
+
+        // the witness must be one of the intersections, with both of its segments
+        ASSERT_EQ(received->segments.size(), 2u);
+        auto it = std::find_if(expected.begin(), expected.end(),
+            [&](const sweepline::intersection_t &it) { return it.pt == received->pt; });
+        ASSERT_NE(it, expected.end());
+        EXPECT_TRUE(std::includes(it->segments.begin(), it->segments.end(),
+                                  received->segments.begin(), received->segments.end()));
+    }
+}
+
+TEST_F(EdgeCases, RedBlue){
+    for(std::string inputf: { "edge_case_star.txt", "edge_case_butterfly.txt", "edge_case_grid_lines_with_single_oblique.txt",
+                              "edge_case_vertical_parallel.txt", "edge_case_triangle_in_triangle.txt",
+                              "star_at_origin.txt", "complicated_sample_test.txt", "rand1.txt" }) {
+        SCOPED_TRACE(inputf);
+        auto segments = data_files::input(inputf);
+
+        // the first half is red and the rest blue, so ids are the same as in the whole list
+        size_t num_red = segments.size() / 2;
+        std::vector<geometry::segment_t> red(segments.begin(), segments.begin() + num_red);
+        std::vector<geometry::segment_t> blue(segments.begin() + num_red, segments.end());
+
+        auto expected = sweepline::find_intersections(segments);
+        expected.erase(std::remove_if(expected.begin(), expected.end(),
+            [&](const sweepline::intersection_t &it) {
+                return it.segments.front() >= num_red or it.segments.back() < num_red;
+            }), expected.end());
+
+        auto received = sweepline::find_red_blue_intersections(red, blue);
+
+        data_files::expect_same(expected, received);
+    }
+}
+
+TEST_F(EdgeCases, QueryWindow){
+    for(std::string inputf: { "edge_case_star.txt", "edge_case_butterfly.txt", "edge_case_grid_lines_with_single_oblique.txt",
+                              "edge_case_vertical_parallel.txt", "edge_case_vertical_oblique_cross.txt",
+                              "edge_case_horizontal_parallel.txt", "star_at_origin.txt", "complicated_sample_test.txt", "rand1.txt" }) {
+        SCOPED_TRACE(inputf);
+        auto segments = data_files::input(inputf);
+        auto all = sweepline::find_intersections(segments);
+
+        geometry::float_t lo_x = 1e18, lo_y = 1e18, hi_x = -1e18, hi_y = -1e18;
+        for(auto &seg: segments) {
+            lo_x = std::min(lo_x, seg.p.x), hi_x = std::max(hi_x, seg.q.x);
+            lo_y = std::min({ lo_y, seg.p.y, seg.q.y }), hi_y = std::max({ hi_y, seg.p.y, seg.q.y });
+        }
+
+        // the whole input, each quarter of it and a few windows whose sides pass through intersections
+        std::vector<sweepline::query_window> windows { { { lo_x, lo_y }, { hi_x, hi_y } } };
+        geometry::float_t mid_x = (lo_x + hi_x) / 2, mid_y = (lo_y + hi_y) / 2;
+        windows.push_back({ { lo_x, lo_y }, { mid_x, mid_y } });
+        windows.push_back({ { mid_x, lo_y }, { hi_x, mid_y } });
+        windows.push_back({ { lo_x, mid_y }, { mid_x, hi_y } });
+        windows.push_back({ { mid_x, mid_y }, { hi_x, hi_y } });
+        for(size_t i = 0; i < all.size(); i += 1 + all.size() / 4)
+            windows.push_back({ all[i].pt, { hi_x, hi_y } }), windows.push_back({ { lo_x, lo_y }, all[i].pt });
+
+        for(auto &window: windows) {
+            SCOPED_TRACE(testing::Message() << "window " << window.lo.x << " " << window.lo.y
+                                            << " " << window.hi.x << " " << window.hi.y);
+            std::vector<sweepline::intersection_t> expected;
+            for(auto &it: all)
+                if(window.contains(it.pt))
+                    expected.push_back(it);
+
+            auto received = sweepline::find_intersections(segments, window);
+
+            data_files::expect_same(expected, received);
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <sweepline.hpp>
+#include "data_files.hpp"
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace {
+
+class Parallel : public testing::TestWithParam<size_t> {
+
+protected:
+
+    std::vector<geometry::segment_t> random_segments(size_t n, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<geometry::float_t> coord(-1000, 1000), len(-100, 100);
+
+        std::vector<geometry::segment_t> segments;
+        for(size_t i = 0; i < n; i++) {
+            geometry::float_t x1 = coord(rng), y1 = coord(rng);
+            geometry::float_t x2 = x1 + len(rng), y2 = y1 + len(rng);
+
+            if(std::make_pair(x1, y1) > std::make_pair(x2, y2))
+                std::swap(x1, x2), std::swap(y1, y2);
+
+            segments.emplace_back(geometry::segment_t{ geometry::point_t{ x1, y1 }, geometry::point_t{ x2, y2 }, i });
+        }
+
+        return segments;
+    }
+
+    void expect_same_as_serial(const std::vector<geometry::segment_t> &segments) {
+        auto expected = sweepline::find_intersections(segments);
+        auto received = sweepline::find_intersections_parallel(segments, GetParam());
+
+        data_files::expect_same(expected, received);
+
+        // the flat list holds the same intersections, in the same order
+        auto list = sweepline::find_intersection_list_parallel(segments, GetParam());
+        ASSERT_EQ(list.size(), received.size());
+        for(size_t i = 0; i < received.size(); i++) {
+            EXPECT_EQ(received[i].pt, list.points[i]);
+            EXPECT_EQ(received[i].segments, list.at(i).segments);
+        }
+    }
+
+};
+
+TEST_P(Parallel, DataFiles) {
+    for(auto fname: {
+        "complicated_sample_test.txt",
+        "oblique_parallel_lines.txt",
+        "parallel_lines.txt",
+        "rand1.txt",
+        "sample_test.txt",
+        "sample_test1.txt",
+        "sample_test2.txt",
+        "sample_test3.txt",
+        "star_at_origin.txt",
+        "edge_case_grid_lines_with_single_oblique.txt",
+        "edge_case_vertical_oblique_cross.txt",
+        "edge_case_coordinate_axes_1.txt",
+        "edge_case_triangle_in_triangle.txt"
+    }) {
+        SCOPED_TRACE(fname);
+        expect_same_as_serial(data_files::input(fname));
+    }
+}
+
+TEST_P(Parallel, RandomSegments) {
+    for(unsigned seed = 1; seed <= 5; seed++) {
+        SCOPED_TRACE(seed);
+        expect_same_as_serial(random_segments(2000, seed));
+    }
+}
+
+TEST_P(Parallel, SmallExtents) {
+    // every slab is swept in the frame fitted to the whole input, so its tolerances are those of the serial sweep
+    // at any extent, e.g. a few hundred metres in degrees of longitude and latitude, or a millimetre around the origin
+    for(auto [center, scale]: { std::pair{ 37.7, 1e-5 }, std::pair{ 0.0, 1e-6 } })
+        for(unsigned seed = 1; seed <= 5; seed++) {
+            SCOPED_TRACE(testing::Message() << "center " << center << ", scale " << scale << ", seed " << seed);
+            auto segments = random_segments(2000, seed);
+            for(auto &seg: segments)
+                for(auto *pt: { &seg.p, &seg.q })
+                    pt->x = center + pt->x * scale, pt->y = center + pt->y * scale;
+
+            // points are compared exactly, since EPS in the coordinates of the input spans the whole of it
+            data_files::expect_identical(sweepline::find_intersections(segments),
+                sweepline::find_intersections_parallel(segments, GetParam()));
+        }
+}
+
+INSTANTIATE_TEST_SUITE_P(Threads, Parallel, testing::Values(1, 2, 3, 4, 7));
+
+} // namespace
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <sweepline.hpp>
+#include "data_files.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+template <typename T>
+class ScalarType : public testing::Test {
+
+protected:
+
+    // the oblique grid of the benchmarks, scaled to the square [-1, 1] x [-1, 1]
+    static std::vector<geometry::basic_segment<T>> oblique_grid(size_t num_horiz, size_t num_verti) {
+        std::vector<geometry::basic_segment<T>> segments;
+        for(size_t i = 0; i < num_horiz; i++) {
+            T y = T(-1) + T(i) / T(num_horiz);
+            segments.push_back({ { -1, y }, { 1, y + 2 }, segments.size() });
+        }
+
+        for(size_t i = 0; i < num_verti; i++) {
+            T y = T(1) + T(i) / T(num_verti);
+            segments.push_back({ { -1, y }, { 1, y - 2 }, segments.size() });
+        }
+
+        return segments;
+    }
+
+    // segments in the square [-1000, 1000] x [-1000, 1000], generated in double and rounded to T
+    static std::vector<geometry::basic_segment<T>> random_segments(size_t n, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> coord(-1000, 1000), len(-200, 200);
+
+        std::vector<geometry::basic_segment<T>> segments;
+        for(size_t i = 0; i < n; i++) {
+            T x1 = T(coord(rng)), y1 = T(coord(rng));
+            T x2 = T(x1 + len(rng)), y2 = T(y1 + len(rng));
+            if(std::make_pair(x1, y1) > std::make_pair(x2, y2))
+                std::swap(x1, x2), std::swap(y1, y2);
+
+            segments.push_back({ { x1, y1 }, { x2, y2 }, i });
+        }
+
+        return segments;
+    }
+
+};
+
+using ScalarTypes = testing::Types<float, double>;
+TYPED_TEST_SUITE(ScalarType, ScalarTypes);
+
+TYPED_TEST(ScalarType, DataFiles) {
+    for(std::string fname: {
+        "complicated_sample_test.txt", "edge_case_another_nested_y.txt", "edge_case_butterfly.txt",
+        "edge_case_coordinate_axes_1.txt", "edge_case_coordinate_axes_3.txt", "edge_case_disappointed_face.txt",
+        "edge_case_grid_lines_with_single_oblique.txt", "edge_case_horizontal_oblique_cross.txt",
+        "edge_case_horizontal_parallel.txt", "edge_case_narrowing_downwards.txt", "edge_case_nested_y.txt",
+        "edge_case_origin_intersect_1.txt", "edge_case_origin_intersect_3.txt",
+        "edge_case_parallels_intersect_oblique.txt", "edge_case_star.txt", "edge_case_triangle_in_triangle.txt",
+        "edge_case_vertical_oblique_cross.txt", "edge_case_vertical_parallel.txt", "star_at_origin.txt", "rand1.txt"
+    }) {
+
+        SCOPED_TRACE(fname);
+        auto expected = data_files::expected_output<sweepline::basic_intersection<TypeParam>>("expected/" + fname);
+        auto received = data_files::sorted(sweepline::find_intersections(
+            data_files::input<geometry::basic_segment<TypeParam>>(fname)));
+
+        /* basic_point == is overloaded to work within the tolerance of its scalar type */
+        data_files::expect_same(expected, received);
+    }
+}
+
+TYPED_TEST(ScalarType, ObliqueGrid) {
+    // counts which are not powers of two leave the intersections at inexact, nearly equal x coordinates
+    for(auto [num_horiz, num_verti]: { std::pair{ 6, 10 }, { 5, 7 }, { 64, 32 }, { 100, 37 } }) {
+        SCOPED_TRACE(std::to_string(num_horiz) + "x" + std::to_string(num_verti));
+        auto counts = sweepline::count_intersections(this->oblique_grid(num_horiz, num_verti));
+        EXPECT_EQ(counts.num_points, size_t(num_horiz * num_verti));
+        EXPECT_EQ(counts.num_pairs, size_t(num_horiz * num_verti));
+    }
+}
+
+TYPED_TEST(ScalarType, MatchesDouble) {
+    auto narrow = this->oblique_grid(48, 40);
+    std::vector<geometry::segment_t> wide;
+    for(auto &seg: narrow)
+        wide.push_back({ { seg.p.x, seg.p.y }, { seg.q.x, seg.q.y }, seg.seg_id });
+
+    auto expected = sweepline::find_intersections(wide);
+    auto received = sweepline::find_intersections(narrow);
+
+    ASSERT_EQ(expected.size(), received.size());
+    for(size_t i = 0; i < expected.size(); i++) {
+        EXPECT_NEAR(expected[i].pt.x, received[i].pt.x, geometry::tolerance<TypeParam>);
+        EXPECT_NEAR(expected[i].pt.y, received[i].pt.y, geometry::tolerance<TypeParam>);
+        EXPECT_EQ(expected[i].segments, received[i].segments);
+    }
+}
+
+TYPED_TEST(ScalarType, ScaleInvariant) {
+    // the solver sweeps in a frame fitted to the extent of its input, so the input scaled by a power of two is swept
+    // exactly as the input itself, down to extents where an absolute tolerance would merge distinct crossings
+    for(unsigned seed: { 21, 30, 36 }) {
+        SCOPED_TRACE(seed);
+        auto segments = this->random_segments(1500, seed);
+        auto expected = sweepline::find_intersections(segments);
+
+        for(int k: { -10, 10, 20, 30, 40 }) {
+            SCOPED_TRACE(k);
+            auto scaled = segments;
+            for(auto &seg: scaled)
+                for(auto *pt: { &seg.p, &seg.q })
+                    pt->x = std::ldexp(pt->x, -k), pt->y = std::ldexp(pt->y, -k);
+
+            auto received = sweepline::find_intersections(scaled);
+
+            // scaling by a power of two is exact, and so is scaling back
+            ASSERT_EQ(expected.size(), received.size());
+            for(size_t i = 0; i < expected.size(); i++) {
+                EXPECT_EQ(std::ldexp(expected[i].pt.x, -k), received[i].pt.x) << "intersection " << i;
+                EXPECT_EQ(std::ldexp(expected[i].pt.y, -k), received[i].pt.y) << "intersection " << i;
+                EXPECT_EQ(expected[i].segments, received[i].segments) << "intersection " << i;
+            }
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <sweepline.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+
+namespace {
+
+TEST(SegmentOrdering, Stars) {
+    // many stars of segments through a common integer point, crossing one another and each other's stars
+    std::mt19937 rng(19);
+    std::uniform_int_distribution<int> center(-50, 50), dir(-30, 30);
+
+    for(int iter = 0; iter < 50; iter++) {
+        SCOPED_TRACE(iter);
+        std::vector<geometry::segment_t> segments;
+
+        for(int star = 0; star < 4; star++) {
+            geometry::point_t c { double(center(rng)), double(center(rng)) };
+            std::vector<std::pair<int, int>> dirs;
+
+            while(dirs.size() < 12) {
+                int dx = dir(rng), dy = dir(rng);
+                if(dx <= 0 or std::gcd(dx, dy) != 1
+                  or std::find(dirs.begin(), dirs.end(), std::pair{ dx, dy }) != dirs.end())
+                    continue;
+                dirs.emplace_back(dx, dy);
+
+                geometry::point_t p { c.x - dx, c.y - dy }, q { c.x + 2 * dx, c.y + 2 * dy };
+                geometry::segment_t seg { p, q, segments.size() };
+
+                // overlapping segments are not supported
+                bool overlaps = std::any_of(segments.begin(), segments.end(), [&](const geometry::segment_t &other) {
+                    return geometry::cross_prod(seg.p, seg.q, other.p) == 0 and geometry::cross_prod(seg.p, seg.q, other.q) == 0;
+                });
+                if(!overlaps)
+                    segments.push_back(seg);
+            }
+        }
+
+        size_t expected = 0;
+        for(size_t i = 0; i < segments.size(); i++)
+            for(size_t j = 0; j < i; j++)
+                expected += geometry::is_intersecting(segments[i], segments[j]);
+
+        sweepline::solver solver(segments, false, false);
+        EXPECT_EQ(solver.count().num_pairs, expected);
+    }
+}
+
+TEST(SegmentOrdering, StarComparisons) {
+#ifndef SWEEPLINE_STATS
+    GTEST_SKIP() << "comparisons are only counted when built with SWEEPLINE_STATS";
+#else
+    // the segments of a star cross at its center without being compared again
+    for(size_t n: { 64, 256, 1024 }) {
+        SCOPED_TRACE(n);
+
+        std::vector<geometry::segment_t> segments;
+        for(size_t i = 0; i < n; i++) {
+            double theta = M_PI * ((i + 0.5) / n - 0.5);     // within (-pi/2, pi/2), so that p < q
+            double dx = std::cos(theta), dy = std::sin(theta);
+            segments.push_back({ { -100 * dx, -100 * dy }, { 100 * dx, 100 * dy }, i });
+        }
+
+        sweepline::solver solver(segments, false, false);
+        auto result = solver.solve();
+
+        ASSERT_EQ(result.size(), 1u);
+        EXPECT_EQ(result[0].segments.size(), n);
+
+        // searches around each of the 2n end points take about 8 n log n comparisons,
+        // erasing and reinserting every segment at the center would take over 10 n log n
+        EXPECT_LE(solver.num_comparisons(), 9 * n * size_t(std::log2(n)));
+    }
+#endif
+}
+
+TEST(SegmentOrdering, StarEvents) {
+    // the d segments of a star are each scheduled once at its center, however many neighbours they had there
+    for(size_t n: { 3, 64, 1000 }) {
+        SCOPED_TRACE(n);
+
+        std::vector<geometry::segment_t> segments;
+        for(size_t i = 0; i < n; i++) {
+            double theta = M_PI * ((i + 0.5) / n - 0.5), dx = std::cos(theta), dy = std::sin(theta);
+            segments.push_back({ { -100 * dx, -100 * dy }, { 100 * dx, 100 * dy }, i });
+        }
+
+        sweepline::solver solver(segments, false, false);
+        auto counts = solver.count();
+        EXPECT_EQ(counts.num_points, 1u);
+        EXPECT_EQ(counts.num_pairs, n * (n - 1) / 2);
+
+        EXPECT_LE(solver.event_counts().max_queue_size, n);
+        EXPECT_EQ(solver.event_counts().stale_events, 0u);
+    }
+}
+
+TEST(SegmentOrdering, HandlesStayReachable) {
+    // every segment in the status is reached by walking it from its first node, whichever end of it segments go in at,
+    // checked between events whenever an intersection is handed over. Short segments spread over a small area,
+    // e.g. GPS coordinates, used to leave the first node behind when a segment was inserted before it
+    std::mt19937 rng(17);
+
+    for(auto [x, y, spread]: { std::tuple{ 0.0, 0.0, 2.0 }, std::tuple{ -122.4, 37.7, 0.02 } }) {
+        std::uniform_real_distribution<double> cx(x - spread / 2, x + spread / 2), cy(y - spread / 2, y + spread / 2);
+        std::uniform_real_distribution<double> d(-spread / 10, spread / 10);
+
+        for(int iter = 0; iter < 10; iter++) {
+            SCOPED_TRACE(iter);
+
+            std::vector<geometry::segment_t> segments;
+            for(size_t i = 0; i < 1000; i++) {
+                geometry::point_t p { cx(rng), cy(rng) }, q { p.x + d(rng), p.y + d(rng) };
+                if(q.x < p.x)
+                    std::swap(p, q);
+                segments.push_back({ p, q, i });
+            }
+
+            sweepline::solver solver(segments, false, false);
+            size_t num_checked = 0, num_valid = 0;
+            solver.solve([&](sweepline::intersection_t &&) {
+                num_checked++;
+                num_valid += solver.handles_are_valid();
+            });
+
+            EXPECT_GT(num_checked, 0u);
+            EXPECT_EQ(num_valid, num_checked);
+            EXPECT_TRUE(solver.handles_are_valid());
+        }
+    }
+}
+
+TEST(SegmentOrdering, NearlyConcurrent) {
+    // segments through points within EPS of one another meet at a single point, where each of them is
+    // found through its handle, however far floating point error puts it from the others at the sweepline.
+    // EPS holds in the frame the solver sweeps in, which fits the stars, of extent 20, to basic_frame::span
+    double scale = sweepline::basic_frame<double>::fit({ { { -9, -9 }, { 11, 11 }, 0 } }).scale;
+    std::mt19937 rng(23);
+    std::uniform_real_distribution<double> jitter(-geometry::EPS / 64 / scale, geometry::EPS / 64 / scale), offset(0, 1);
+
+    for(int iter = 0; iter < 100; iter++) {
+        SCOPED_TRACE(iter);
+
+        size_t n = 2 + iter % 40;
+        std::vector<geometry::segment_t> segments;
+        for(size_t i = 0; i < n; i++) {
+            // far enough apart that each pair crosses within EPS of the others
+            double theta = -1.5 + 3 * (i + offset(rng) / 2) / n, dx = std::cos(theta), dy = std::sin(theta);
+            geometry::point_t c { 1 + jitter(rng), 1 + jitter(rng) };
+            segments.push_back({ { c.x - 10 * dx, c.y - 10 * dy }, { c.x + 10 * dx, c.y + 10 * dy }, i });
+        }
+
+        auto counts = sweepline::solver(segments, false, false).count();
+        EXPECT_EQ(counts.num_points, 1u);
+        EXPECT_EQ(counts.num_pairs, n * (n - 1) / 2);
+    }
+}
+
+} // namespace
@@ -0,0 +1,105 @@
+/**
+ 🍪 the_hyp0cr1t3
+ 🍪 17.10.2026 18:42:10
+**/
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+#include <red_black_tree.tpp>
+
+// Stress tests building trees from sorted ranges against std::set, exits with 1 on the first mismatch
+
+using ordered_tree = BBST::red_black_tree<int, std::less<int>, BBST::node_pool<int>, BBST::order_statistics_node_update>;
+
+template <class Tree>
+bool same(const Tree &tree, const std::set<int> &s) {
+    return tree.is_valid() and tree.size() == s.size() and std::equal(s.begin(), s.end(), tree.begin());
+}
+
+int main(int argc, char *argv[]) {
+    std::mt19937 rng(argc > 1? std::atoi(argv[1]) : 25);
+    auto randInt = [&rng](int L, int R) {
+        return std::uniform_int_distribution<int>(L, R)(rng);
+    };
+
+    auto fail = [](const char *what, size_t n) {
+        std::cout << "FAIL: " << what << " of " << n << " keys" << std::endl;
+        return 1;
+    };
+
+    // every size up to a few levels, and some larger ones
+    std::vector<size_t> sizes;
+    for(size_t n = 0; n <= 300; n++)
+        sizes.push_back(n);
+    for(size_t n: { 1023, 1024, 1025, 4095, 100000 })
+        sizes.push_back(n);
+
+    for(size_t n: sizes) {
+        std::set<int> s;
+        while(s.size() < n)
+            s.insert(randInt(-1000000, 1000000));
+        std::vector<int> keys(s.begin(), s.end());
+
+        // built in linear time, then modified one key at a time
+        BBST::red_black_tree<int> tree(keys.begin(), keys.end());
+        if(!same(tree, s))
+            return fail("build", n);
+
+        for(int q = 0; q < 200; q++) {
+            int val = randInt(-1000000, 1000000);
+            if(q % 2 and !keys.empty())
+                val = keys[randInt(0, keys.size() - 1)];
+
+            if(q % 3) {
+                tree.insert(val);
+                s.insert(val);
+            } else {
+                tree.erase(val);
+                s.erase(val);
+            }
+        }
+        if(!same(tree, s))
+            return fail("modifying a build", n);
+
+        // the sizes of the subtrees are built along with them
+        ordered_tree ordered(keys.begin(), keys.end());
+        if(!same(ordered, std::set<int>(keys.begin(), keys.end())))
+            return fail("ordered build", n);
+        for(size_t k = 0; k < n; k += 1 + n / 50)
+            if(*ordered.find_by_order(k) != keys[k] or ordered.order_of_key(keys[k]) != k)
+                return fail("ordered build ranks", n);
+
+        // appended past the greatest key, without searching
+        std::vector<int> more;
+        for(int x = (s.empty()? 0 : *s.rbegin()) + 1; more.size() < n / 2 + 1; x += randInt(1, 5))
+            more.push_back(x);
+        tree.insert(more.begin(), more.end());
+        s.insert(more.begin(), more.end());
+        if(!same(tree, s))
+            return fail("append", n);
+
+        // neither sorted nor past the greatest key, inserted one by one
+        std::vector<int> shuffled(keys.begin(), keys.end());
+        shuffled.push_back(randInt(-1000000, 1000000));
+        std::shuffle(shuffled.begin(), shuffled.end(), rng);
+        tree.insert(shuffled.begin(), shuffled.end());
+        s.insert(shuffled.begin(), shuffled.end());
+        if(!same(tree, s))
+            return fail("unsorted insert", n);
+
+        // sorted with repeats, or not past the greatest key
+        std::vector<int> repeats { 1, 1, 2 };
+        BBST::red_black_tree<int> small(repeats.begin(), repeats.end());
+        small.insert(keys.begin(), keys.end());
+        std::set<int> small_set(repeats.begin(), repeats.end());
+        small_set.insert(keys.begin(), keys.end());
+        if(!same(small, small_set))
+            return fail("insert with repeats", n);
+    }
+
+    std::cout << "OK" << std::endl;
+
+} // ~W
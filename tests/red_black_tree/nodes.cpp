@@ -0,0 +1,213 @@
+/**
+ 🍪 the_hyp0cr1t3
+ 🍪 17.10.2026 20:05:37
+**/
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <red_black_tree.tpp>
+
+// Checks how red_black_tree allocates, frees, extracts and recycles its nodes, exits with 1 on the first failure
+
+// allocates from the heap, counting the objects allocated and not yet deallocated
+long num_live = 0;
+
+template <class T>
+struct counting_allocator {
+    using value_type = T;
+
+    counting_allocator() = default;
+    template <class U>
+    counting_allocator(const counting_allocator<U> &) {}
+
+    T *allocate(size_t n) { num_live += n; return std::allocator<T>().allocate(n); }
+    void deallocate(T *p, size_t n) { num_live -= n; std::allocator<T>().deallocate(p, n); }
+
+    friend bool operator == (const counting_allocator &, const counting_allocator &) { return true; }
+    friend bool operator != (const counting_allocator &, const counting_allocator &) { return false; }
+};
+
+// allocates from a node pool, counting the slabs it allocates
+long num_slabs = 0;
+
+template <class T>
+struct counting_pool : BBST::node_pool<T> {
+    counting_pool() = default;
+    template <class U>
+    counting_pool(const counting_pool<U> &) {}
+
+    T *allocate(size_t n) {
+        size_t before = this->num_slabs();
+        T *p = BBST::node_pool<T>::allocate(n);
+        num_slabs += this->num_slabs() - before;
+        return p;
+    }
+};
+
+void check(bool ok, const char *what) {
+    if(!ok) {
+        std::cout << "FAIL: " << what << std::endl;
+        std::exit(1);
+    }
+}
+
+// every node is returned to the allocator once erased, or along with the tree
+void frees_nodes() {
+    {
+        BBST::red_black_tree<int, std::less<int>, counting_allocator<int>> tree;
+        for(int i = 0; i < 1000; i++)
+            tree.insert(i);
+        check(num_live == 1000, "nodes allocated on insert");
+
+        tree.erase(tree.lower_bound(100), tree.lower_bound(600));
+        check(num_live == 500 and tree.size() == 500 and *tree.lower_bound(100) == 600, "range erase");
+
+        for(int i = 0; i < 100; i++)
+            tree.erase(i);
+        check(num_live == 400, "nodes freed on erase");
+
+        // the nodes move along with the tree, the one moved from is left empty and usable
+        auto moved = std::move(tree);
+        check(num_live == 400, "nodes kept on move");
+        check(tree.empty() and tree.begin() == tree.end(), "moved from tree is empty");
+        tree.insert(1);
+        check(*moved.begin() == 600 and moved.size() == 400, "moved to tree");
+    }
+    check(num_live == 0, "nodes freed with the tree");
+}
+
+// a node taken out and put back keeps its memory, with its key changed or not
+void extracts_nodes() {
+    {
+        BBST::red_black_tree<int, std::less<int>, counting_allocator<int>> tree;
+        for(int i = 0; i < 100; i++)
+            tree.insert(i);
+
+        auto nh = tree.extract(tree.find(10));
+        check(tree.size() == 99 and !tree.contains(10) and nh.value() == 10, "extract");
+
+        nh.value() = 1000;
+        auto result = tree.insert(std::move(nh));
+        check(result.inserted and *result.position == 1000 and nh.empty() and num_live == 100, "insert extracted");
+
+        // a node whose key is already there is handed back
+        nh = tree.extract(20);
+        nh.value() = 30;
+        result = tree.insert(std::move(nh));
+        check(!result.inserted and *result.position == 30 and result.node.value() == 30 and num_live == 100,
+            "insert extracted duplicate");
+
+        result.node = {};
+        check(num_live == 99, "node freed with its handle");
+        check(tree.extract(12345).empty(), "extract missing key");
+
+        // nodes move between trees whose allocators compare equal
+        BBST::red_black_tree<int, std::less<int>, counting_allocator<int>> other;
+        check(other.insert(tree.extract(tree.begin())).inserted, "insert into another tree");
+        check(*other.begin() == 0 and *tree.begin() == 1 and num_live == 99, "node moved between trees");
+
+        check(tree.emplace(5000).second and !tree.emplace(5000).second, "emplace");
+        check(num_live == 100 and tree.size() == 99 and tree.contains(5000), "emplace duplicate frees its node");
+    }
+    check(num_live == 0, "nodes freed with the trees");
+
+    // but not between trees with separate pools
+    BBST::red_black_tree<int> a { 1, 2, 3 }, b;
+    bool thrown = false;
+    try {
+        b.insert(a.extract(a.begin()));
+    } catch(const std::runtime_error &) {
+        thrown = true;
+    }
+    check(thrown and a.size() == 2, "insert from a separate pool");
+
+    // keys are moved in, not copied
+    BBST::red_black_tree<std::vector<int>> vectors;
+    std::vector<int> key(100, 7);
+    const int *data = key.data();
+    vectors.insert(std::move(key));
+    check(key.empty() and vectors.begin()->data() == data, "keys moved in");
+}
+
+// nodes erased are handed out again before any new slab is allocated
+void recycles_nodes() {
+    BBST::node_pool<int> pool;
+    std::vector<int *> first, second;
+
+    for(int i = 0; i < 1000; i++)
+        first.push_back(pool.allocate(1));
+    size_t slabs = pool.num_slabs();
+    check(slabs <= 10, "slabs double in size");
+
+    for(int *p: first)
+        pool.deallocate(p, 1);
+    for(int i = 0; i < 1000; i++)
+        second.push_back(pool.allocate(1));
+    check(pool.num_slabs() == slabs, "no slab allocated while recycling");
+
+    std::sort(first.begin(), first.end());
+    std::sort(second.begin(), second.end());
+    check(first == second and std::adjacent_find(second.begin(), second.end()) == second.end(), "slots recycled");
+
+    // a tree churning at a steady size allocates no more slabs than it did growing to it
+    BBST::red_black_tree<int, std::less<int>, counting_pool<int>> tree;
+    for(int i = 0; i < 1000; i++)
+        tree.insert(i);
+    long grown = num_slabs;
+    check(grown > 0, "slabs allocated growing");
+
+    for(int i = 1000; i < 100000; i++) {
+        tree.erase(tree.begin());
+        tree.insert(i);
+    }
+    check(num_slabs == grown and tree.size() == 1000 and *tree.begin() == 99000, "no slab allocated churning");
+}
+
+// a handle holds a copy of the pool of its tree, which shares its slabs, so it may outlive the tree,
+// and a node extracted before the tree is moved is returned to the pool which moved along with the tree
+void handles_outlive_trees() {
+    BBST::red_black_tree<int>::node_type nh;
+    {
+        BBST::red_black_tree<int> tree { 1, 2, 3 };
+        nh = tree.extract(2);
+    }
+    check(nh.value() == 2, "handle outlives its tree");
+    nh = {};
+
+    BBST::red_black_tree<int> tree { 1, 2, 3 };
+    nh = tree.extract(1);
+    auto moved = std::move(tree);
+    check(moved.insert(std::move(nh)).inserted and moved.size() == 3, "insert into the tree moved to");
+
+    nh = moved.extract(3);
+    const int *slot = &nh.value();
+    nh = {};
+
+    // the tree moved from allocates from a pool of its own, and the node freed is recycled by the tree moved to
+    tree.insert(10);
+    check(&*tree.find(10) != slot, "tree moved from has its own pool");
+    moved.insert(4);
+    check(&*moved.find(4) == slot, "node returned to the pool of the tree moved to");
+
+    bool thrown = false;
+    try {
+        tree.insert(moved.extract(4));
+    } catch(const std::runtime_error &) {
+        thrown = true;
+    }
+    check(thrown, "insert into the tree moved from");
+}
+
+int main() {
+    frees_nodes();
+    extracts_nodes();
+    recycles_nodes();
+    handles_outlive_trees();
+
+    std::cout << "OK" << std::endl;
+
+} // ~W
@@ -0,0 +1,139 @@
+/**
+ 🍪 the_hyp0cr1t3
+ 🍪 17.10.2026 20:11:52
+**/
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include <red_black_tree.tpp>
+
+// Checks reversing runs of a red_black_tree in place, and its order statistics against std::set,
+// exits with 1 on the first failure
+
+// orders keys ascending, except for those in [lo, hi) which are ordered descending once flipped,
+// as segments crossing at the sweepline change their order
+struct flipping_less {
+    const bool *flipped;
+    int lo, hi;
+
+    bool operator () (int a, int b) const {
+        if(*flipped and lo <= a and a < hi and lo <= b and b < hi)
+            return b < a;
+        return a < b;
+    }
+};
+
+void check(bool ok, const std::string &what) {
+    if(!ok) {
+        std::cout << "FAIL: " << what << std::endl;
+        std::exit(1);
+    }
+}
+
+void reverses_in_place() {
+    for(auto [lo, hi]: { std::pair{ 20, 40 }, { 0, 100 }, { 0, 1 }, { 99, 100 }, { 50, 50 }, { 10, 13 } }) {
+        std::string run = " of [" + std::to_string(lo) + ", " + std::to_string(hi) + ")";
+
+        bool flipped = false;
+        BBST::red_black_tree<int, flipping_less> tree(flipping_less{ &flipped, lo, hi });
+        for(int i = 99; i >= 0; i--)
+            tree.insert(i);
+
+        // the run is found by the order before the flip
+        auto first = tree.lower_bound(lo), last = tree.lower_bound(hi);
+        flipped = true;
+        tree.reverse(first, last);
+
+        std::vector<int> expected(100);
+        std::iota(expected.begin(), expected.end(), 0);
+        std::reverse(expected.begin() + lo, expected.begin() + hi);
+        check(std::vector<int>(tree.begin(), tree.end()) == expected and tree.is_valid(), "reverse" + run);
+
+        // the tree is searchable and modifiable by the new order
+        check(tree.size() == 100 and *tree.begin() == expected.front(), "size after reverse" + run);
+        for(int i = 0; i < 100; i++)
+            check(tree.contains(i), "search after reverse" + run);
+
+        tree.erase(expected[50]);
+        tree.insert(100);
+        expected.erase(expected.begin() + 50);
+        expected.push_back(100);
+        check(std::vector<int>(tree.begin(), tree.end()) == expected, "modify after reverse" + run);
+    }
+}
+
+// ranks and selections agree with a set through insertions, erases, extractions and range erases
+void order_statistics() {
+    std::mt19937 rng(24);
+    std::uniform_int_distribution<int> key(-500, 500), op(0, 9);
+
+    BBST::red_black_tree<int, std::less<int>, BBST::node_pool<int>, BBST::order_statistics_node_update> tree;
+    std::set<int> expected;
+
+    auto same = [&]() {
+        check(tree.size() == expected.size(), "size");
+        size_t k = 0;
+        for(int x: expected) {
+            auto itr = tree.find_by_order(k);
+            check(itr != tree.end() and *itr == x, "find_by_order");
+            check(tree.order_of(itr) == k and tree.order_of_key(x) == k, "order_of");
+            k++;
+        }
+        check(tree.find_by_order(k) == tree.end() and tree.order_of(tree.end()) == k, "past the end");
+    };
+
+    for(int iter = 0; iter < 5000; iter++) {
+        int x = key(rng);
+
+        switch(op(rng)) {
+        case 0: case 1: case 2: case 3:
+            check(tree.insert(x).second == expected.insert(x).second, "insert");
+            break;
+        case 4: case 5:
+            check(tree.erase(x) == (expected.erase(x) == 1), "erase");
+            break;
+        case 6:
+            if(!expected.empty()) {
+                // a node taken out and put back with another key
+                auto nh = tree.extract(tree.find_by_order(rng() % expected.size()));
+                expected.erase(nh.value());
+                nh.value() = x;
+                check(tree.insert(std::move(nh)).inserted == expected.insert(x).second, "insert extracted");
+            }
+            break;
+        case 7:
+            check(tree.order_of_key(x) == size_t(std::distance(expected.begin(), expected.lower_bound(x))),
+                "order_of_key");
+            break;
+        case 8:
+            if(iter % 50 == 0) {
+                tree.erase(tree.lower_bound(x), tree.lower_bound(x + 20));
+                expected.erase(expected.lower_bound(x), expected.lower_bound(x + 20));
+            }
+            break;
+        default:
+            tree.emplace(x);
+            expected.insert(x);
+        }
+
+        if(iter % 100 == 0)
+            same();
+    }
+
+    same();
+}
+
+int main() {
+    reverses_in_place();
+    order_statistics();
+
+    std::cout << "OK" << std::endl;
+
+} // ~W